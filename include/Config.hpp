@@ -75,6 +75,8 @@ DECLARE_CONFIG(Config,
     CONFIG_VALUE(HideText, bool, "Hide Player Text", true, "Whether to hide the REPLAY player text for locally saved replays")
     CONFIG_VALUE(TextHeight, float, "Player Text Height", 7, "The height of the REPLAY player text when visible")
     CONFIG_VALUE(Avatar, bool, "Enable Avatar", true, "Shows avatar when in third person camera mode")
+    CONFIG_VALUE(PackReplays, bool, "Pack Old Replays", false, "Compresses old BeatLeader replays into a few large files, making them unusable by other mods")
+    CONFIG_VALUE(PackAge, int, "Pack Age", 30, "Number of days before a replay is packed")
 
     CONFIG_VALUE(Walls, bool, "PC Walls", true, "Whether to use PC walls when rendering")
     CONFIG_VALUE(Mirrors, int, "PC Mirrors", 3, "PC Mirrors level to use when rendering")
@@ -85,6 +87,7 @@ DECLARE_CONFIG(Config,
     CONFIG_VALUE(Bitrate, int, "Bitrate", 50000)
     CONFIG_VALUE(FOV, float, "FOV", 70)
     CONFIG_VALUE(FPS, int, "FPS", 60)
+    CONFIG_VALUE(CompressFrames, bool, "Compress Frames", false, "Reduces the memory used by replays while rendering, with a tiny loss in precision")
     CONFIG_VALUE(CameraOff, bool, "Disable Camera", false, "Disables the main camera to speed up renders")
 
     CONFIG_VALUE(Pauses, bool, "Allow Pauses", false, "Whether to allow the game to pause while rendering")
@@ -93,6 +96,8 @@ DECLARE_CONFIG(Config,
 
     CONFIG_VALUE(TimeButton, ButtonPair, "Skip Forward|Skip Backward", {}, "Skips around in the time while watching a replay")
     CONFIG_VALUE(TimeSkip, int, "Time Skip Amount", 5, "Number of seconds to skip per button press")
+    CONFIG_VALUE(ScrubButton, Button, "Scrub Button", {}, "Scrubs through the replay with the joystick on the same controller while held, including backwards")
+    CONFIG_VALUE(ScrubSpeed, float, "Scrub Speed", 4, "The playback speed when scrubbing with the joystick fully pushed")
     CONFIG_VALUE(SpeedButton, ButtonPair, "Speed Up|Slow Down", {}, "Changes playback speed while watching a replay")
     CONFIG_VALUE(MoveButton, Button, "Movement Button", {}, "Enables moving to a desired third person position when held")
     CONFIG_VALUE(TravelButton, ButtonPair, "Travel Forward|Travel Backward", {}, "Moves the environment around you in third person")
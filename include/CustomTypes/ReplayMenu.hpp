@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Replay.hpp"
+
 #include "GlobalNamespace/LevelBar.hpp"
 #include "GlobalNamespace/StandardLevelDetailView.hpp"
 #include "GlobalNamespace/IReadonlyBeatmapData.hpp"
@@ -13,8 +15,6 @@
 
 #include "custom-types/shared/macros.hpp"
 
-struct ReplayInfo;
-
 namespace Menu {
     void EnsureSetup(GlobalNamespace::StandardLevelDetailView* view);
 
@@ -23,7 +23,7 @@ namespace Menu {
 
     void CheckMultiplayer();
 
-    void SetReplays(std::vector<std::pair<std::string, ReplayInfo*>> replays, bool external = false);
+    void SetReplays(std::shared_ptr<const ReplayList> replays, bool external = false);
 
     void PresentMenu();
     void DismissMenu();
@@ -41,9 +41,9 @@ DECLARE_CLASS_CODEGEN(Menu, ReplayViewController, HMUI::ViewController,
     DECLARE_INSTANCE_METHOD(void, OnEnable);
 
     public:
-        void SetReplays(std::vector<std::pair<std::string, ReplayInfo*>> replays);
+        void SetReplays(std::shared_ptr<const ReplayList> replays);
         void SelectReplay(int index);
-        std::string& GetReplay();
+        const std::string& GetReplay();
     private:
         GlobalNamespace::LevelBar* levelBar;
         TMPro::TextMeshProUGUI* sourceText;
@@ -59,7 +59,7 @@ DECLARE_CLASS_CODEGEN(Menu, ReplayViewController, HMUI::ViewController,
         QuestUI::IncrementSetting* increment;
         HMUI::ModalView* confirmModal;
 
-        std::vector<std::pair<std::string, ReplayInfo*>> replays;
+        std::shared_ptr<const ReplayList> replays;
         GlobalNamespace::IDifficultyBeatmap* beatmap;
         GlobalNamespace::IReadonlyBeatmapData* beatmapData;
 )
@@ -2,6 +2,8 @@
 
 #include "Replay.hpp"
 
+#include <istream>
+
 struct ReplayNoteCutInfo {
     bool speedOK;
     bool directionOK;
@@ -48,6 +50,19 @@ struct WallEvent {
     short width;
     float time;
     float endTime;
+    // filled by BuildTimeline
+    // false if the head was already in an earlier wall, in which case the combo isn't broken again
+    bool entersWall = true;
+    // time in contact with walls that this wall adds on top of earlier ones
+    float addedContact = 0;
+};
+
+// a span of time in contact with at least one wall
+struct WallInterval {
+    float start;
+    float end;
+    // total contact time of all earlier intervals
+    float contactBefore;
 };
 
 struct HeightEvent {
@@ -81,17 +96,84 @@ struct EventCompare {
     }
 };
 
-struct EventReplay : public virtual Replay {
-    std::vector<NoteEvent> notes;
-    std::vector<WallEvent> walls;
-    std::vector<HeightEvent> heights;
-    std::vector<PauseEvent> pauses;
-    std::set<EventRef, EventCompare> events;
-    bool needsRecalculation;
-    bool cutInfoMissingOKs;
+// an event that has to be sent to the game during playback, with its target worked out ahead of time
+struct DispatchEvent {
+    enum Type : char {
+        NoteCut,
+        NoteMiss,
+        BombCut,
+        // the head enters a wall while not already in one
+        WallEnter,
+        // the head is already in a wall, so this only adds contact time
+        WallContact
+    };
+    float time;
+    // the note key for notes, see NoteKey
+    int key;
+    // index into notes or walls
+    int index;
+    Type type;
+};
+
+// groups notes by everything but scoring type, since some replays don't record it
+// not unique for mapping extensions notes, so matches still need to compare the fields
+constexpr int NoteKey(int lineIndex, int lineLayer, int colorType, int cutDirection) {
+    return lineIndex * 1000 + lineLayer * 100 + colorType * 10 + cutDirection;
+}
+
+// running totals from simulating events in order, see ScoreStateAtTime
+struct ScoreState {
+    int multiplier = 1;
+    int multiplierProgress = 0;
+    int maxMultiplier = 1;
+    int maxMultiplierProgress = 0;
+    // wall contact time already applied to energy
+    float wallContact = 0;
+    int score = 0;
+    int maxScore = 0;
+    int combo = 0;
+    int maxCombo = 0;
+    float energy = 0.5;
+    float recentNoteTime = -1;
 };
 
+struct EventData {
+    EventData(std::pmr::memory_resource* arena) : notes(arena), walls(arena), heights(arena), pauses(arena), events(arena), wallIntervals(arena), dispatch(arena), scoreCheckpoints(arena) {}
+
+    std::pmr::vector<NoteEvent> notes;
+    std::pmr::vector<WallEvent> walls;
+    std::pmr::vector<HeightEvent> heights;
+    std::pmr::vector<PauseEvent> pauses;
+    // every event in time order, see BuildTimeline
+    std::pmr::vector<EventRef> events;
+    // every wall merged into disjoint intervals in time order, see BuildTimeline
+    std::pmr::vector<WallInterval> wallIntervals;
+    // note and wall events in time order, see BuildDispatch
+    std::pmr::vector<DispatchEvent> dispatch;
+    // the score state before every few events, filled the first time it is needed
+    std::pmr::vector<ScoreState> scoreCheckpoints;
+    bool needsRecalculation = false;
+    bool cutInfoMissingOKs = false;
+};
+
+// fills events by merging the per-type arrays, which should each already be in time order, and computes wall contact
+void BuildTimeline(EventData& data);
+
+// fills dispatch from events, needs to be redone if note info changes
+void BuildDispatch(EventData& data);
+
+// total time in contact with walls up to the time
+float WallContactUntil(const EventData& data, float time);
+
+// the end of the events at or before the time
+std::pmr::vector<EventRef>::const_iterator EventsUntil(const EventData& data, float time);
+
+// counts come straight from replay files, so only reserve as many items as the rest of the file could hold
+size_t ReserveCount(std::istream& input, std::streampos end, int count, size_t itemSize);
+
 ReplayWrapper ReadBSOR(const std::string& path);
+// path is only used for logging
+ReplayWrapper ReadBSOR(std::istream& input, const std::string& path);
 
 namespace GlobalNamespace{ class IReadonlyBeatmapData; }
 void RecalculateNotes(ReplayWrapper& replay, GlobalNamespace::IReadonlyBeatmapData* beatmapData);
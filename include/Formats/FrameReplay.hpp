@@ -15,8 +15,21 @@ struct ScoreFrame {
         time(time), score(score), percent(percent), combo(combo), energy(energy), offset(offset) {}
 };
 
-struct FrameReplay : public virtual Replay {
-    std::vector<ScoreFrame> scoreFrames;
+// a range of score frame positions where a combo drop is expected, see Frames::AllowComboDrop
+struct ComboDropWindow {
+    int begin;
+    int end;
+};
+
+struct ScoreData {
+    ScoreData(std::pmr::memory_resource* arena) : scoreFrames(arena), checkpoints(arena), comboDrops(arena) {}
+
+    std::pmr::vector<ScoreFrame> scoreFrames;
+    // the latest value of each field before every few frames, filled the first time it is needed
+    std::pmr::vector<ScoreFrame> checkpoints;
+    // sorted and filled when playback starts
+    std::pmr::vector<ComboDropWindow> comboDrops;
+    bool comboDropsBuilt = false;
 };
 
 ReplayWrapper ReadReqlay(const std::string& path);
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+
+namespace GlobalNamespace {
+    class IPreviewBeatmapLevel;
+    class IDifficultyBeatmap;
+}
+
+// parts of replay file names that only depend on the level, safe to copy to other threads
+struct LevelKeys {
+    std::string levelID;
+    std::string songName;
+    // lowercased hash used by reqlays
+    std::string hash;
+    // level id without the songloader prefix, used by beatleader
+    std::string bsorHash;
+    // scoresaber marks base game levels with an extra prefix
+    std::string ssHash;
+};
+
+struct DifficultyKeys {
+    // reqlay file name without the extension
+    std::string reqlayName;
+    // substring of matching bsor file names
+    std::string bsorSearch;
+    // suffix of matching scoresaber file names
+    std::string ssEnding;
+};
+
+LevelKeys MakeLevelKeys(const std::string& levelID, const std::string& songName);
+
+// both are memoized, so repeated lookups for the same level don't need to touch il2cpp strings
+const LevelKeys& GetLevelKeys(GlobalNamespace::IPreviewBeatmapLevel* level);
+const DifficultyKeys& GetDifficultyKeys(GlobalNamespace::IDifficultyBeatmap* beatmap);
@@ -6,7 +6,16 @@ namespace Pause {
     void EnsureSetup(GlobalNamespace::PauseMenuManager* pauseMenu);
     void OnUnpause();
 
+    // speeds above 2 fast forward silently
     void SetSpeed(float speed);
+    // the next speed up or down from the current one
+    float StepSpeed(float speed, int direction);
     void PreviewTime(float time);
     void SetTime(float time);
+    float ClampTime(float time);
+
+    // scrubbing mutes the song and hides objects, then shows the score at each time until the time is set when it ends
+    void StartScrub();
+    void PreviewScrub(float time);
+    void EndScrub(float time);
 }
@@ -1,4 +1,11 @@
 #pragma once
+#include <vector>
+#include <array>
+#include <optional>
+#include <memory_resource>
+#include <memory>
+#include <string>
+
 #include "sombrero/shared/FastVector3.hpp"
 #include "sombrero/shared/FastQuaternion.hpp"
 
@@ -77,10 +84,128 @@ struct Frame {
         time(time), fps(fps), head(head), leftHand(leftHand), rightHand(rightHand) {}
 };
 
+// frames stored column by column, so searching through times doesn't pull in pose data
+class FrameStore {
+    public:
+    void Add(const Frame& frame);
+    void Reserve(size_t count);
+    void Erase(size_t begin, size_t end);
+
+    // quantizes the poses to about a third of their size, after which they can't be modified
+    void Compress();
+    bool IsCompressed() const { return compressed; }
+
+    size_t Size() const { return times.size(); }
+    bool Empty() const { return times.empty(); }
+
+    Frame operator[](size_t index) const;
+
+    const std::vector<float>& Times() const { return times; }
+    // only for loading, as the uncompressed poses are cleared by Compress
+    std::vector<Transform>& Heads() { return heads; }
+
+    private:
+    struct Block {
+        Vector3 origin;
+        float scale;
+    };
+    // positions are 16 bit offsets from the origin of each block of frames, within 0.1mm unless a block spans several meters
+    // rotations are the three smallest quaternion components at 10 bits each, plus the index of the largest
+    // which puts them within about 0.3 degrees, the worst case being when all four components are close to 1/2
+    // test/FrameCompressionTest.cpp checks both bounds
+    struct PackedTrack {
+        std::vector<Block> blocks;
+        std::vector<std::array<int16_t, 3>> positions;
+        std::vector<uint32_t> rotations;
+    };
+    struct FpsRun {
+        size_t start;
+        int fps;
+    };
+
+    void Pack(std::vector<Transform>& transforms, PackedTrack& track);
+    Transform Unpack(const PackedTrack& track, size_t index) const;
+    int GetFps(size_t index) const;
+
+    bool compressed = false;
+    std::vector<float> times;
+    std::vector<int> fps;
+    std::vector<Transform> heads;
+    std::vector<Transform> leftHands;
+    std::vector<Transform> rightHands;
+
+    std::vector<FpsRun> fpsRuns;
+    PackedTrack packedHeads;
+    PackedTrack packedLeftHands;
+    PackedTrack packedRightHands;
+};
+
+// cubic curves through the frames around the cursor, so poses between frames don't depend on the capture rate
+class FrameSpline {
+    public:
+    // fits the segment from the frame to the next one, reusing what is already cached
+    void Fit(const FrameStore& frames, int frame);
+    void Reset();
+
+    // progress is the fraction of the way through the segment
+    Frame Evaluate(float progress) const;
+
+    private:
+    // position then rotation components for each of the head, left hand, and right hand
+    static constexpr int trackChannels = 7;
+    // padded to a multiple of the vector width
+    static constexpr int channelCount = 24;
+
+    void FitTrack(int offset, Transform Frame::*track);
+
+    const FrameStore* source = nullptr;
+    int segment = -1;
+    // the frames before, at the start, at the end, and after the segment
+    std::array<Frame, 4> window;
+    std::array<int, 4> windowIndices = {-1, -1, -1, -1};
+    // coefficients of a + bt + ct^2 + dt^3 stored by power, so every channel is evaluated in one vectorized loop
+    alignas(16) std::array<float, channelCount> a = {};
+    alignas(16) std::array<float, channelCount> b = {};
+    alignas(16) std::array<float, channelCount> c = {};
+    alignas(16) std::array<float, channelCount> d = {};
+};
+
+// allocates the parsed events of a replay in large blocks that are all freed together with it
+class ReplayArena : public std::pmr::memory_resource {
+    public:
+    // size of the first block, which readers set from the file before parsing events
+    void SetSizeHint(size_t bytes) { sizeHint = bytes; }
+
+    private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if(!blocks)
+            blocks.emplace(std::max(sizeHint, bytes + alignment));
+        return blocks->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    size_t sizeHint = 16 * 1024;
+    std::optional<std::pmr::monotonic_buffer_resource> blocks;
+};
+
+struct EventData;
+struct ScoreData;
+
 struct Replay {
+    // needs to be the first member so it outlives every container using it
+    ReplayArena arena;
     ReplayInfo info;
-    std::vector<Frame> frames;
-    virtual ~Replay() = default;
+    FrameStore frames;
+    // only present for formats that record them, matching the flags in ReplayWrapper::type
+    std::unique_ptr<EventData> eventData;
+    std::unique_ptr<ScoreData> scoreData;
+
+    Replay();
+    ~Replay();
+
+    EventData& AddEventData();
+    ScoreData& AddScoreData();
 };
 
 struct ReplayWrapper {
@@ -92,3 +217,6 @@ struct ReplayWrapper {
 
     bool IsValid() const { return (bool) replay; }
 };
+
+// replay files paired with their parsed data, shared as a whole between the menu and playback
+using ReplayList = std::vector<std::pair<std::string, ReplayWrapper>>;
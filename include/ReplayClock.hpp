@@ -0,0 +1,38 @@
+#pragma once
+
+// song time used for playback, independent of unity and the game so it can be driven by anything
+class ReplayClock {
+    public:
+    enum struct Mode {
+        // follows the time reported by the audio
+        AudioLocked,
+        // adds up frame delta times
+        WallClock,
+        // moves exactly one step of 1 / fps per frame, so renders don't depend on how long frames take
+        FixedStep
+    };
+
+    void Start(Mode mode, float time, int fps = 60);
+    // for seeks, keeps the mode and the max drift
+    void Seek(float time);
+    // moves forward by one frame and returns the new time, audioTime is only used in audio locked mode
+    float Advance(float deltaTime, float timeScale, float audioTime);
+    // compares to the time reported by the audio, which should only be done while it is playing
+    void MeasureDrift(float audioTime);
+
+    Mode GetMode() const { return mode; }
+    float GetTime() const { return time; }
+    float GetDrift() const { return drift; }
+    float GetMaxDrift() const { return maxDrift; }
+
+    private:
+    Mode mode = Mode::AudioLocked;
+    int fps = 60;
+    // fixed steps count from the last seek or speed change instead of adding up, to avoid rounding errors
+    double stepStart = 0;
+    long steps = 0;
+    float stepScale = 1;
+    float time = 0;
+    float drift = 0;
+    float maxDrift = 0;
+};
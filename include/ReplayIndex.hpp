@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Replay.hpp"
+#include "LevelKeys.hpp"
+
+namespace Index {
+    // crc32 of the file contents, cached until the file's size or modification time changes
+    // calculated on demand if the indexing job hasn't reached the file yet
+    std::optional<uint32_t> GetFingerprint(const std::string& path);
+    // crc32 of data in memory, matching the fingerprint of a file with the same contents
+    uint32_t CalculateCrc(const char* data, size_t size);
+
+    // reads a replay, reusing the parsed data of any other file with identical contents
+    ReplayWrapper LoadReplay(const std::string& path, ReplayWrapper(*reader)(const std::string&));
+
+    // stops sharing the parsed data, for when it was modified for a single use
+    void Evict(const Replay* replay);
+
+    // collapses replays that share parsed data into the first entry for them
+    void Deduplicate(ReplayList& replays);
+
+    void Forget(const std::string& path);
+
+    // fingerprints every replay file in the background, resuming from the checkpoint saved by previous launches
+    void StartIndexing();
+
+    // file names in a directory, only listed again once the directory has been modified
+    std::shared_ptr<const std::vector<std::string>> ListDirectory(const std::string& path);
+
+    // parses the replays for all difficulties of a level in the background, cancelling any previous prefetch
+    void Prefetch(const LevelKeys& level);
+    void CancelPrefetch();
+}
@@ -28,6 +28,7 @@ namespace GlobalNamespace {
     class AudioManagerSO;
     class BeatmapObjectManager;
     class BeatmapCallbacksController;
+    class AudioTimeSyncController;
 }
 
 namespace Manager {
@@ -71,17 +72,21 @@ namespace Manager {
 
     namespace Events {
         extern float wallEnergyLoss;
+        // moves past events before the time without processing them, for when their results are restored separately
+        void SkipTo(float time);
         void AddNoteController(GlobalNamespace::NoteController* note);
         void RemoveNoteController(GlobalNamespace::NoteController* note);
     }
 
     void SetLevel(GlobalNamespace::IDifficultyBeatmap* level);
 
-    void SetReplays(std::vector<std::pair<std::string, ReplayWrapper>> replays, bool external = false);
+    void SetReplays(ReplayList replays, bool external = false);
     void RefreshLevelReplays();
     bool AreReplaysLocal();
+    // the local replays of the last level set, or null if they were replaced by external ones
+    std::shared_ptr<const ReplayList> GetLevelReplays();
 
-    void ReplayStarted(ReplayWrapper& wrapper);
+    void ReplayStarted(const ReplayWrapper& wrapper);
     void ReplayStarted(const std::string& path);
     void ReplayRestarted(bool full = true);
     void ReplayEnded(bool quit);
@@ -90,16 +95,35 @@ namespace Manager {
 
     extern bool replaying;
     extern bool paused;
+    // song time is driven by the joystick instead of the audio while true
+    extern bool scrubbing;
+    // playing faster than the audio can, with the song muted and following real time
+    extern bool fastForwarding;
     extern ReplayWrapper currentReplay;
     extern GlobalNamespace::IDifficultyBeatmap* beatmap;
 
     const ReplayInfo& GetCurrentInfo();
 
     void UpdateTime(float songTime);
+    void SetFastForward(bool fastForward);
+    // whether the song time comes from the replay clock instead of the audio
+    bool ClockDrivesSong();
+    // advances the replay clock after the audio controller updates, overriding its song time if the clock drives it
+    void UpdateClock(GlobalNamespace::AudioTimeSyncController* audio);
     void SetLastCutTime(float lastCutTime);
     void CheckInputs();
     float GetSongTime();
-    const Frame& GetFrame();
-    const Frame& GetNextFrame();
+    Frame GetFrame();
+    Frame GetNextFrame();
     float GetFrameProgress();
+
+    // transforms interpolated to the current time, calculated once per update so hooks only need to read them
+    struct Pose {
+        Transform head;
+        Transform leftHand;
+        Transform rightHand;
+        // relative to the origin instead of in world space
+        bool local;
+    };
+    const Pose& GetPose();
 }
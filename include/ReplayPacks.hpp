@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Replay.hpp"
+
+namespace Packs {
+    // whether the path refers to a replay that was moved into a pack file
+    bool IsPacked(const std::string& path);
+
+    // crc32 of the original file contents, matching Index::GetFingerprint
+    std::optional<uint32_t> GetCrc(const std::string& path);
+
+    ReplayWrapper Load(const std::string& path);
+
+    // file names of packed replays that were originally in the directory
+    std::vector<std::string> ListPacked(const std::string& directory);
+
+    void Remove(const std::string& path);
+
+    // moves bsors older than the configured age into pack files, leaving recent ones for beatleader
+    void PackColdReplays();
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Replay.hpp"
+#include "LevelKeys.hpp"
 
 #include "GlobalNamespace/IPreviewBeatmapLevel.hpp"
 #include "GlobalNamespace/IDifficultyBeatmap.hpp"
@@ -19,7 +20,13 @@ std::string GetBSORsPath();
 
 std::string GetHash(GlobalNamespace::IPreviewBeatmapLevel* level);
 
-std::vector<std::pair<std::string, ReplayWrapper>> GetReplays(GlobalNamespace::IDifficultyBeatmap* beatmap);
+ReplayList GetReplays(GlobalNamespace::IDifficultyBeatmap* beatmap);
+
+using ReplayReader = ReplayWrapper(*)(const std::string& path);
+
+// replay files for every difficulty of a level, without using il2cpp so it can be called from any thread
+std::vector<std::pair<std::string, ReplayReader>> FindLevelReplayFiles(const LevelKeys& level);
+std::vector<std::pair<std::string, ReplayReader>> FindAllReplayFiles();
 
 std::string SecondsToString(int value);
 
@@ -49,10 +56,16 @@ struct MapPreview {
     int maxScore;
 };
 
+// simulates events from the nearest checkpoint, so only event replays are supported
+struct ScoreState ScoreStateAtTime(const ReplayWrapper& replay, float time);
+
 MapPreview MapAtTime(const ReplayWrapper& replay, float time);
 
 bool IsButtonDown(const class Button& button);
 
 int IsButtonDown(const class ButtonPair& button);
 
+// horizontal joystick position from -1 to 1, using whichever is pushed further if both controllers are allowed
+float GetJoystickX(int controller);
+
 void PlayDing();
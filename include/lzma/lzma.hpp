@@ -6,7 +6,7 @@ extern "C" {
 #include <vector>
 
 namespace LZMA {
-    // both of these are highly non-threadsafe, if two of these calls (even different ones) run at the same time it *will* mess things up.
+    // each call has its own coder state, so these can run on several threads at once
     bool lzmaDecompress(const std::vector<char>& in, std::vector<char>& out);
     bool lzmaCompress(const std::vector<char>& in, std::vector<char>& out);
 }
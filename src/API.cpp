@@ -9,13 +9,14 @@
 
 #include "Formats/EventReplay.hpp"
 #include "ReplayManager.hpp"
+#include "ReplayIndex.hpp"
 #include "CustomTypes/ReplayMenu.hpp"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wreturn-type-c-linkage"
 
 EXPOSE_API(PlayBSORFromFile, bool, std::string filePath) {
-    auto replay = ReadBSOR(filePath);
+    auto replay = Index::LoadReplay(filePath, ReadBSOR);
     if (replay.IsValid()) {
         auto levelView = UnityEngine::Resources::FindObjectsOfTypeAll<GlobalNamespace::StandardLevelDetailView*>().First();
 
@@ -29,7 +30,7 @@ EXPOSE_API(PlayBSORFromFile, bool, std::string filePath) {
 }
 
 EXPOSE_API(PlayBSORFromFileForced, bool, std::string filePath) {
-    auto replay = ReadBSOR(filePath);
+    auto replay = Index::LoadReplay(filePath, ReadBSOR);
     if (replay.IsValid()) {
         auto levelView = UnityEngine::Resources::FindObjectsOfTypeAll<GlobalNamespace::StandardLevelDetailView*>().First();
 
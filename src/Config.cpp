@@ -254,6 +254,10 @@ void MainSettings::DidActivate(bool firstActivation, bool addedToHierarchy, bool
     AddConfigValueIncrementFloat(transform, getConfig().TextHeight, 1, 0.2, 0, 10);
 
     AddConfigValueToggle(transform, getConfig().Avatar);
+
+    AddConfigValueToggle(transform, getConfig().PackReplays);
+
+    AddConfigValueIncrementInt(transform, getConfig().PackAge, 1, 1, 365);
 }
 
 #include "MenuSelection.hpp"
@@ -297,6 +301,8 @@ void RenderSettings::DidActivate(bool firstActivation, bool addedToHierarchy, bo
 
     AddConfigValueToggle(rendering, getConfig().CameraOff);
 
+    AddConfigValueToggle(rendering, getConfig().CompressFrames);
+
     AddConfigValueToggle(rendering, getConfig().Pauses);
 
     AddConfigValueToggle(rendering, getConfig().Ding);
@@ -394,6 +400,10 @@ void InputSettings::DidActivate(bool firstActivation, bool addedToHierarchy, boo
 
     AddConfigValueIncrementInt(inputs, getConfig().TimeSkip, 1, 1, 30);
 
+    AddConfigValueDropdown(inputs, getConfig().ScrubButton);
+
+    AddConfigValueIncrementFloat(inputs, getConfig().ScrubSpeed, 1, 0.5, 0.5, 16);
+
     AddConfigValueDropdown(inputs, getConfig().SpeedButton);
 
     AddConfigValueDropdown(inputs, getConfig().MoveButton);
@@ -26,16 +26,14 @@ void CameraRig::Update() {
             bool enabled = Manager::Camera::GetMode() == (int) CameraMode::ThirdPerson;
             avatar->get_gameObject()->SetActive(enabled);
             if(enabled) {
-                auto& frame = Manager::GetFrame();
-                auto& nextFrame = Manager::GetNextFrame();
-                float lerp = Manager::GetFrameProgress();
+                auto& pose = Manager::GetPose();
                 avatar->UpdateTransforms(
-                    Vector3::Lerp(frame.head.position, nextFrame.head.position, lerp),
-                    Vector3::Lerp(frame.leftHand.position, nextFrame.leftHand.position, lerp),
-                    Vector3::Lerp(frame.rightHand.position, nextFrame.rightHand.position, lerp),
-                    Quaternion::Lerp(frame.head.rotation, nextFrame.head.rotation, lerp),
-                    Quaternion::Lerp(frame.leftHand.rotation, nextFrame.leftHand.rotation, lerp),
-                    Quaternion::Lerp(frame.rightHand.rotation, nextFrame.rightHand.rotation, lerp)
+                    pose.head.position,
+                    pose.leftHand.position,
+                    pose.rightHand.position,
+                    pose.head.rotation,
+                    pose.leftHand.rotation,
+                    pose.rightHand.rotation
                 );
             }
         }
@@ -12,6 +12,10 @@ DEFINE_TYPE(ReplayHelpers, MovementData);
 using namespace ReplayHelpers;
 using namespace GlobalNamespace;
 
+// finished instances are kept for the next cut instead of leaving them to the gc
+// safe pointers so they aren't collected while sitting in the pool
+std::vector<SafePtr<MovementData>> pool;
+
 BladeMovementDataElement MovementData::get_lastAddedData() {
     return baseData->get_lastAddedData();
 }
@@ -60,10 +64,18 @@ void MovementData::ProcessNewData(BladeMovementDataElement newData, BladeMovemen
         counter->Finish(); // TODO: this likely causes finishes to be in an arbitrary order, causing at least part of the scoring issue
     }
     baseData->RemoveDataProcessor((ISaberMovementDataProcessor*) this);
+    baseData = nullptr;
+    dataProcessor = nullptr;
+    pool.emplace_back(this);
 }
 
 ISaberMovementData* MakeFakeMovementData(ISaberMovementData* baseData, float beforeCutRating, float afterCutRating) {
-    auto movementData = CRASH_UNLESS(il2cpp_utils::New<MovementData*>());
+    MovementData* movementData;
+    if(!pool.empty()) {
+        movementData = static_cast<MovementData*>(pool.back());
+        pool.pop_back();
+    } else
+        movementData = CRASH_UNLESS(il2cpp_utils::New<MovementData*>());
     movementData->baseData = baseData;
     movementData->beforeCutRating = beforeCutRating;
     movementData->afterCutRating = afterCutRating;
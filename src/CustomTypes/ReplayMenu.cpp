@@ -3,6 +3,7 @@
 
 #include "Formats/FrameReplay.hpp"
 #include "ReplayManager.hpp"
+#include "ReplayIndex.hpp"
 #include "Utils.hpp"
 #include "Sprites.hpp"
 #include "Config.hpp"
@@ -68,6 +69,7 @@ void OnDeleteButtonClick() {
     if(!usingLocalReplays)
         return;
     try {
+        Index::Forget(viewController->GetReplay());
         std::filesystem::remove(viewController->GetReplay());
     } catch (const std::filesystem::filesystem_error& e) {
         LOG_ERROR("Failed to delete replay: {}", e.what());
@@ -161,7 +163,7 @@ namespace Menu {
             SetButtonEnabled(false);
     }
 
-    void SetReplays(std::vector<std::pair<std::string, ReplayInfo*>> replays, bool external) {
+    void SetReplays(std::shared_ptr<const ReplayList> replays, bool external) {
         usingLocalReplays = !external;
         viewController->SetReplays(replays);
     }
@@ -291,7 +293,7 @@ void Menu::ReplayViewController::DidActivate(bool firstActivation, bool addedToH
     deleteIcon->get_transform()->set_localScale({0.8, 0.8, 0.8});
     deleteIcon->set_preserveAspect(true);
 
-    increment = BeatSaberUI::CreateIncrementSetting(mainLayout, "", 0, 1, getConfig().LastReplayIdx.GetValue() + 1, 1, replays.size(), OnIncrementChanged);
+    increment = BeatSaberUI::CreateIncrementSetting(mainLayout, "", 0, 1, getConfig().LastReplayIdx.GetValue() + 1, 1, replays ? replays->size() : 0, OnIncrementChanged);
     Object::Destroy(increment->GetComponent<UI::HorizontalLayoutGroup*>());
     ((RectTransform*) increment->get_transform()->GetChild(1))->set_anchoredPosition({-20, 0});
 
@@ -318,23 +320,23 @@ void Menu::ReplayViewController::OnEnable() {
         queueButton->set_interactable(!IsCurrentLevelInConfig());
 }
 
-void Menu::ReplayViewController::SetReplays(std::vector<std::pair<std::string, ReplayInfo*>> replayInfos) {
-    replays = replayInfos;
-    if(getConfig().LastReplayIdx.GetValue() >= replayInfos.size())
-        getConfig().LastReplayIdx.SetValue(replayInfos.size() - 1);
+void Menu::ReplayViewController::SetReplays(std::shared_ptr<const ReplayList> newReplays) {
+    replays = newReplays;
+    if(getConfig().LastReplayIdx.GetValue() >= replays->size())
+        getConfig().LastReplayIdx.SetValue(replays->size() - 1);
     auto lastBeatmap = beatmap;
     beatmap = levelView->selectedDifficultyBeatmap;
     if(lastBeatmap != beatmap) {
         beatmapData = nullptr;
-        GetBeatmapData(beatmap, [this, replayInfos](IReadonlyBeatmapData* data) {
+        GetBeatmapData(beatmap, [this, newReplays](IReadonlyBeatmapData* data) {
             beatmapData = data;
-            if(replays == replayInfos && increment) {
+            if(replays == newReplays && increment) {
                 UpdateUI();
             }
         });
     }
     if(increment) {
-        increment->MaxValue = replayInfos.size();
+        increment->MaxValue = replays->size();
         increment->CurrentValue = getConfig().LastReplayIdx.GetValue() + 1;
         increment->UpdateValue();
     }
@@ -345,8 +347,8 @@ void Menu::ReplayViewController::SelectReplay(int index) {
     UpdateUI();
 }
 
-std::string& Menu::ReplayViewController::GetReplay() {
-    return replays[getConfig().LastReplayIdx.GetValue()].first;
+const std::string& Menu::ReplayViewController::GetReplay() {
+    return (*replays)[getConfig().LastReplayIdx.GetValue()].first;
 }
 
 void Menu::ReplayViewController::UpdateUI() {
@@ -357,7 +359,7 @@ void Menu::ReplayViewController::UpdateUI() {
     levelBar->Setup(level, characteristic, difficulty);
     float songLength = level->get_songDuration();
 
-    auto info = replays[getConfig().LastReplayIdx.GetValue()].second;
+    auto info = &(*replays)[getConfig().LastReplayIdx.GetValue()].second.replay->info;
 
     sourceText->set_text(GetLayeredText("Replay Source:  ", info->source, false));
     std::string date = GetStringForTimeSinceNow(info->timestamp);
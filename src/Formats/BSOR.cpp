@@ -5,31 +5,36 @@
 
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 
 // loading code for beatleader's replay format: https://github.com/BeatLeader/BS-Open-Replay
 
+// only needed while loading, so the strings can be allocated from a buffer on the stack
 struct BSORInfo {
-    std::string version;
-    std::string gameVersion;
-    std::string timestamp;
+    BSORInfo(std::pmr::memory_resource* resource) : resource(resource) {}
+    std::pmr::memory_resource* resource;
 
-    std::string playerID;
-    std::string playerName;
-    std::string platform;
+    std::pmr::string version{resource};
+    std::pmr::string gameVersion{resource};
+    std::pmr::string timestamp{resource};
 
-    std::string trackingSytem;
-    std::string hmd;
-    std::string controller;
+    std::pmr::string playerID{resource};
+    std::pmr::string playerName{resource};
+    std::pmr::string platform{resource};
 
-    std::string hash;
-    std::string songName;
-    std::string mapper;
-    std::string difficulty;
+    std::pmr::string trackingSytem{resource};
+    std::pmr::string hmd{resource};
+    std::pmr::string controller{resource};
+
+    std::pmr::string hash{resource};
+    std::pmr::string songName{resource};
+    std::pmr::string mapper{resource};
+    std::pmr::string difficulty{resource};
 
     int score;
-    std::string mode;
-    std::string environment;
-    std::string modifiers;
+    std::pmr::string mode{resource};
+    std::pmr::string environment{resource};
+    std::pmr::string modifiers{resource};
     float jumpDistance = 0;
     bool leftHanded = false;
     float height = 0;
@@ -64,21 +69,19 @@ bool IsLikelyValidCutInfo(ReplayNoteCutInfo& info) {
 }
 
 #define READ_TO(name) input.read(reinterpret_cast<char*>(&name), sizeof(decltype(name)))
-#define READ_STRING(name) name = ReadString(input)
-#define READ_UTF16(name) name = ReadPotentialUTF16(input)
+#define READ_STRING(name) ReadString(input, name)
+#define READ_UTF16(name) ReadPotentialUTF16(input, name)
 
-std::string ReadString(std::ifstream& input) {
+void ReadString(std::istream& input, std::pmr::string& str) {
     int length;
     READ_TO(length);
-    std::string str;
     str.resize(length);
     input.read(str.data(), length);
-    return str;
 }
 
 // Some strings like name, mapper or song name
 // may contain incorrectly encoded UTF16 symbols.
-std::string ReadPotentialUTF16(std::ifstream& input) {
+void ReadPotentialUTF16(std::istream& input, std::pmr::string& str) {
     int length;
     READ_TO(length);
 
@@ -97,14 +100,11 @@ std::string ReadPotentialUTF16(std::ifstream& input) {
         input.seekg(-length - 4, input.cur);
     }
 
-    std::string str;
     str.resize(length);
     input.read(str.data(), length);
-
-    return str;
 }
 
-ReplayModifiers ParseModifierString(const std::string& modifiers) {
+ReplayModifiers ParseModifierString(std::string_view modifiers) {
     ReplayModifiers ret;
     ret.disappearingArrows = modifiers.find("DA") != std::string::npos;
     ret.fasterSong = modifiers.find("FS") != std::string::npos;
@@ -121,8 +121,8 @@ ReplayModifiers ParseModifierString(const std::string& modifiers) {
     return ret;
 }
 
-BSORInfo ReadInfo(std::ifstream& input) {
-    BSORInfo info;
+BSORInfo ReadInfo(std::istream& input, std::pmr::memory_resource* resource) {
+    BSORInfo info(resource);
     READ_STRING(info.version);
     READ_STRING(info.gameVersion);
     READ_STRING(info.timestamp);
@@ -162,6 +162,16 @@ ReplayWrapper ReadBSOR(const std::string& path) {
         return {};
     }
 
+    return ReadBSOR(input, path);
+}
+
+ReplayWrapper ReadBSOR(std::istream& input, const std::string& path) {
+    auto start = input.tellg();
+    input.seekg(0, std::ios::end);
+    auto end = input.tellg();
+    size_t size = end - start;
+    input.seekg(start);
+
     int header;
     char version;
     char section;
@@ -181,13 +191,16 @@ ReplayWrapper ReadBSOR(const std::string& path) {
         return {};
     }
 
-    auto replay = new EventReplay();
+    auto replay = new Replay();
     ReplayWrapper ret(ReplayType::Event, replay);
+    auto& eventData = replay->AddEventData();
     
-    auto info = ReadInfo(input);
+    char infoBuffer[2048];
+    std::pmr::monotonic_buffer_resource infoArena(infoBuffer, sizeof(infoBuffer));
+    auto info = ReadInfo(input, &infoArena);
     replay->info.modifiers = ParseModifierString(info.modifiers);
     replay->info.modifiers.leftHanded = info.leftHanded;
-    replay->info.timestamp = std::stol(info.timestamp);
+    replay->info.timestamp = std::stol(std::string(info.timestamp));
     replay->info.score = info.score;
     replay->info.source = "BeatLeader";
     replay->info.positionsAreLocal = true;
@@ -210,24 +223,27 @@ ReplayWrapper ReadBSOR(const std::string& path) {
     }
     int framesCount;
     READ_TO(framesCount);
+    replay->frames.Reserve(ReserveCount(input, end, framesCount, sizeof(Frame)));
     QuaternionAverage averageCalc(UnityEngine::Quaternion::Euler({0, 0, 0}));
     // here we have yet another lecagy bug where multiplayer replays record all the avatars
     float firstTime = -1000;
     int skip = 0;
     bool checkDone = false;
     for(int i = 0; i < framesCount; i++) {
-        auto& frame = replay->frames.emplace_back(Frame());
+        Frame frame;
         READ_TO(frame);
         if(firstTime == -1000 && frame.time != 0)
             firstTime = frame.time;
         else if(firstTime == frame.time) {
+            replay->frames.Add(frame);
             skip++;
             continue;
         }
         averageCalc.AddRotation(frame.head.rotation);
+        replay->frames.Add(frame);
         if(skip > 0) {
             if(!checkDone) {
-                replay->frames.erase(replay->frames.begin() + 1, replay->frames.end() - 1);
+                replay->frames.Erase(1, replay->frames.Size() - 1);
                 checkDone = true;
             }
             input.seekg(sizeof(Frame) * skip, std::ios::cur);
@@ -246,17 +262,20 @@ ReplayWrapper ReadBSOR(const std::string& path) {
         LOG_ERROR("Invalid section 2 header in bsor file {}", path);
         return {};
     }
+    // everything left in the file is events, which take up a similar amount of space once parsed
+    replay->arena.SetSizeHint(2 * (size - (input.tellg() - start)));
     int notesCount;
     READ_TO(notesCount);
+    eventData.notes.reserve(ReserveCount(input, end, notesCount, sizeof(BSORNoteEventInfo)));
     BSORNoteEventInfo noteInfo;
     for(int i = 0; i < notesCount; i++) {
-        auto& note = replay->notes.emplace_back(NoteEvent());
+        auto& note = eventData.notes.emplace_back(NoteEvent());
         READ_TO(noteInfo);
 
         // Mapping extensions replays require map data
         // for parsing because of the lost data. Blame NSGolova
         if (noteInfo.noteID >= 1000000 || noteInfo.noteID <= -1000) {
-            replay->needsRecalculation = true;
+            eventData.needsRecalculation = true;
         }
 
         note.info.scoringType = noteInfo.noteID / 10000;
@@ -304,7 +323,6 @@ ReplayWrapper ReadBSOR(const std::string& path) {
                 }
             }
         }
-        replay->events.emplace(note.time, EventRef::Note, replay->notes.size() - 1);
     }
     
     READ_TO(section);
@@ -314,12 +332,13 @@ ReplayWrapper ReadBSOR(const std::string& path) {
     }
     int wallsCount;
     READ_TO(wallsCount);
+    eventData.walls.reserve(ReserveCount(input, end, wallsCount, sizeof(BSORWallEvent)));
     BSORWallEvent wallEvent;
     // oh boy, I get to calculate the end time of wall events based on energy, it's not like anything better could have been done in the recording phase
     float energy = 0.5;
-    auto notesIter = replay->notes.begin();
+    auto notesIter = eventData.notes.begin();
     for(int i = 0; i < wallsCount; i++) {
-        auto& wall = replay->walls.emplace_back(WallEvent());
+        auto& wall = eventData.walls.emplace_back(WallEvent());
         READ_TO(wallEvent);
         wall.lineIndex = wallEvent.wallID / 100;
         wallEvent.wallID -= wall.lineIndex * 100;
@@ -333,13 +352,13 @@ ReplayWrapper ReadBSOR(const std::string& path) {
         if(info.platform == "oculus" || version > 1)
             wall.endTime = wallEvent.energy;
             // replays on yet another BL version just forgot to record wall event end times
-            if(wall.endTime < wall.time || wall.endTime > replay->notes.back().time * 100) {
+            if(wall.endTime < wall.time || wall.endTime > eventData.notes.back().time * 100) {
                 LOG_ERROR("Replay had broken wall event {}", path);
                 return {};
             }
         else {
             // process all note events up to event time
-            while(notesIter != replay->notes.end() && notesIter->time < wallEvent.time) {
+            while(notesIter != eventData.notes.end() && notesIter->time < wallEvent.time) {
                 energy += EnergyForNote(notesIter->info);
                 if(energy > 1)
                     energy = 1;
@@ -348,18 +367,19 @@ ReplayWrapper ReadBSOR(const std::string& path) {
             float diff = energy - wallEvent.energy;
             // only realistic case for this happening (assuming the recorder is correct)
             // is for a wall event's time span to be fully contained inside another wall event
-            if(diff < 0)
+            if(diff < 0) {
+                eventData.walls.pop_back();
                 continue;
+            }
             float seconds = diff / 1.3;
             wall.endTime = wallEvent.time + seconds;
             // now we also correct for any misses that happen during the wall...
-            while(notesIter != replay->notes.end() && notesIter->time < wall.endTime) {
+            while(notesIter != eventData.notes.end() && notesIter->time < wall.endTime) {
                 wall.endTime -= EnergyForNote(notesIter->info) / 1.3;
                 notesIter++;
             }
             energy = wallEvent.energy;
         }
-        replay->events.emplace(wall.time, EventRef::Wall, replay->walls.size() - 1);
     }
     
     READ_TO(section);
@@ -369,10 +389,10 @@ ReplayWrapper ReadBSOR(const std::string& path) {
     }
     int heightCount;
     READ_TO(heightCount);
+    eventData.heights.reserve(ReserveCount(input, end, heightCount, sizeof(HeightEvent)));
     for(int i = 0; i < heightCount; i++) {
-        auto& height = replay->heights.emplace_back(HeightEvent());
+        auto& height = eventData.heights.emplace_back(HeightEvent());
         READ_TO(height);
-        replay->events.emplace(height.time, EventRef::Height, replay->heights.size() - 1);
     }
     replay->info.hasYOffset = true;
     
@@ -383,11 +403,12 @@ ReplayWrapper ReadBSOR(const std::string& path) {
     }
     int pauseCount;
     READ_TO(pauseCount);
+    eventData.pauses.reserve(ReserveCount(input, end, pauseCount, sizeof(PauseEvent)));
     for(int i = 0; i < pauseCount; i++) {
-        auto& pause = replay->pauses.emplace_back(PauseEvent());
+        auto& pause = eventData.pauses.emplace_back(PauseEvent());
         READ_TO(pause);
-        replay->events.emplace(pause.time, EventRef::Height, replay->pauses.size() - 1);
     }
+    BuildTimeline(eventData);
 
     return ret;
 }
@@ -397,20 +418,28 @@ ReplayWrapper ReadBSOR(const std::string& path) {
 #include "System/Collections/Generic/LinkedList_1.hpp"
 #include "System/Collections/Generic/LinkedListNode_1.hpp"
 
-#include <list>
+#include <unordered_map>
 
 using namespace GlobalNamespace;
 
+// note events with the same id, in the order they were recorded
+struct NoteBucket {
+    std::vector<int> events;
+    size_t next = 0;
+
+    int Peek() const { return next < events.size() ? events[next] : -1; }
+};
+
 void RecalculateNotes(ReplayWrapper& replay, IReadonlyBeatmapData* beatmapData) {
     if(replay.type != ReplayType::Event)
         return;
-    auto eventReplay = dynamic_cast<EventReplay*>(replay.replay.get());
-    if(!eventReplay->needsRecalculation)
+    auto& eventData = *replay.replay->eventData;
+    if(!eventData.needsRecalculation)
         return;
-    
-    std::list<NoteEvent*> notes{};
-    for(auto& note : eventReplay->notes)
-        notes.emplace_back(&note);
+
+    std::unordered_map<int, NoteBucket> buckets;
+    for(int i = 0; i < eventData.notes.size(); i++)
+        buckets[BSORNoteID(eventData.notes[i].info)].events.emplace_back(i);
 
     auto list = beatmapData->get_allBeatmapDataItems();
     for(auto i = list->head; i->next != list->head; i = i->next) {
@@ -419,20 +448,29 @@ void RecalculateNotes(ReplayWrapper& replay, IReadonlyBeatmapData* beatmapData)
             continue;
         auto noteData = dataOpt.value();
         int mapNoteId = BSORNoteID(noteData);
-        
-        for(auto iter = notes.begin(); iter != notes.end(); iter++) {
-            auto& info = (*iter)->info;
-            int eventNoteId = BSORNoteID(info);
-            if(mapNoteId == eventNoteId || mapNoteId == (eventNoteId + 30000)) {
-                info.scoringType = noteData->scoringType.value;
-                info.lineIndex = noteData->lineIndex;
-                info.lineLayer = noteData->noteLineLayer.value;
-                info.colorType = noteData->colorType.value;
-                info.cutDirection = noteData->cutDirection.value;
-                notes.erase(iter);
-                break;
-            }
+
+        // events can match either the id or the id with a lower scoring type, whichever was recorded first
+        NoteBucket* bucket = nullptr;
+        for(int eventNoteId : {mapNoteId, mapNoteId - 30000}) {
+            auto found = buckets.find(eventNoteId);
+            if(found == buckets.end() || found->second.Peek() < 0)
+                continue;
+            if(!bucket || found->second.Peek() < bucket->Peek())
+                bucket = &found->second;
         }
+        if(!bucket)
+            continue;
+
+        auto& info = eventData.notes[bucket->Peek()].info;
+        info.scoringType = noteData->scoringType.value;
+        info.lineIndex = noteData->lineIndex;
+        info.lineLayer = noteData->noteLineLayer.value;
+        info.colorType = noteData->colorType.value;
+        info.cutDirection = noteData->cutDirection.value;
+        bucket->next++;
     }
-    eventReplay->needsRecalculation = false;
+    // both depend on the old note info
+    BuildDispatch(eventData);
+    eventData.scoreCheckpoints.clear();
+    eventData.needsRecalculation = false;
 }
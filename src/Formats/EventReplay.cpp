@@ -0,0 +1,95 @@
+#include "Formats/EventReplay.hpp"
+
+#include <algorithm>
+
+template<class T>
+std::vector<EventRef> GetEventRefs(const std::pmr::vector<T>& source, EventRef::Type type) {
+    std::vector<EventRef> ret;
+    ret.reserve(source.size());
+    for(int i = 0; i < source.size(); i++)
+        ret.emplace_back(source[i].time, type, i);
+    // recorders write events in order, but a bad file shouldn't break playback
+    if(!std::is_sorted(ret.begin(), ret.end(), EventCompare()))
+        std::sort(ret.begin(), ret.end(), EventCompare());
+    return ret;
+}
+
+void BuildTimeline(EventData& data) {
+    auto notes = GetEventRefs(data.notes, EventRef::Note);
+    auto walls = GetEventRefs(data.walls, EventRef::Wall);
+    auto heights = GetEventRefs(data.heights, EventRef::Height);
+    auto pauses = GetEventRefs(data.pauses, EventRef::Pause);
+
+    std::vector<EventRef> notesAndWalls;
+    notesAndWalls.reserve(notes.size() + walls.size());
+    std::merge(notes.begin(), notes.end(), walls.begin(), walls.end(), std::back_inserter(notesAndWalls), EventCompare());
+    std::vector<EventRef> heightsAndPauses;
+    heightsAndPauses.reserve(heights.size() + pauses.size());
+    std::merge(heights.begin(), heights.end(), pauses.begin(), pauses.end(), std::back_inserter(heightsAndPauses), EventCompare());
+
+    data.events.clear();
+    data.events.reserve(notesAndWalls.size() + heightsAndPauses.size());
+    std::merge(notesAndWalls.begin(), notesAndWalls.end(), heightsAndPauses.begin(), heightsAndPauses.end(), std::back_inserter(data.events), EventCompare());
+
+    data.wallIntervals.clear();
+    float wallEnd = 0, contact = 0;
+    for(auto& ref : walls) {
+        auto& wall = data.walls[ref.index];
+        // bad files can have walls ending before they start
+        float end = std::max(wall.time, wall.endTime);
+        wall.entersWall = wall.time > wallEnd;
+        wall.addedContact = std::max(end - std::max(wall.time, wallEnd), 0.0f);
+        wallEnd = std::max(wallEnd, end);
+
+        if(data.wallIntervals.empty() || wall.time > data.wallIntervals.back().end)
+            data.wallIntervals.push_back({wall.time, end, contact});
+        else
+            data.wallIntervals.back().end = std::max(data.wallIntervals.back().end, end);
+        contact += wall.addedContact;
+    }
+
+    BuildDispatch(data);
+}
+
+void BuildDispatch(EventData& data) {
+    data.dispatch.clear();
+    data.dispatch.reserve(data.notes.size() + data.walls.size());
+    for(auto& event : data.events) {
+        if(event.eventType == EventRef::Note) {
+            auto& info = data.notes[event.index].info;
+            auto type = DispatchEvent::NoteCut;
+            if(info.eventType == NoteEventInfo::Type::MISS)
+                type = DispatchEvent::NoteMiss;
+            else if(info.eventType == NoteEventInfo::Type::BOMB)
+                type = DispatchEvent::BombCut;
+            int key = NoteKey(info.lineIndex, info.lineLayer, info.colorType, info.cutDirection);
+            data.dispatch.push_back({event.time, key, event.index, type});
+        } else if(event.eventType == EventRef::Wall) {
+            auto type = data.walls[event.index].entersWall ? DispatchEvent::WallEnter : DispatchEvent::WallContact;
+            data.dispatch.push_back({event.time, 0, event.index, type});
+        }
+    }
+}
+
+float WallContactUntil(const EventData& data, float time) {
+    auto next = std::upper_bound(data.wallIntervals.begin(), data.wallIntervals.end(), time, [](float time, const WallInterval& interval) {
+        return time < interval.start;
+    });
+    if(next == data.wallIntervals.begin())
+        return 0;
+    auto& interval = *(next - 1);
+    return interval.contactBefore + std::min(time, interval.end) - interval.start;
+}
+
+std::pmr::vector<EventRef>::const_iterator EventsUntil(const EventData& data, float time) {
+    return std::upper_bound(data.events.begin(), data.events.end(), time, [](float time, const EventRef& event) {
+        return time < event.time;
+    });
+}
+
+size_t ReserveCount(std::istream& input, std::streampos end, int count, size_t itemSize) {
+    auto position = input.tellg();
+    if(count <= 0 || position < 0 || position > end)
+        return 0;
+    return std::min((size_t) count, (size_t) (end - position) / itemSize);
+}
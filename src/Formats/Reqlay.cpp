@@ -110,8 +110,9 @@ Transform ConvertEulerTransform(EulerTransform& trans) {
 #define READ_TO(name) input.read(reinterpret_cast<char*>(&name), sizeof(decltype(name)))
 
 ReplayWrapper ReadFromV1(std::ifstream& input) {
-    auto replay = new FrameReplay();
+    auto replay = new Replay();
     ReplayWrapper ret(ReplayType::Frame, replay);
+    auto& scoreData = replay->AddScoreData();
 
     auto modifiers = V1Modifiers();
     READ_TO(modifiers);
@@ -123,8 +124,8 @@ ReplayWrapper ReadFromV1(std::ifstream& input) {
     auto frame = V1KeyFrame();
     while(READ_TO(frame)) {
         frame.head.rotation = frame.head.rotation * 90;
-        replay->scoreFrames.emplace_back(ScoreFrame(frame.time, frame.score, frame.percent, frame.combo, -1, 0));
-        replay->frames.emplace_back(Frame(ConvertEulerTransform(frame.head), ConvertEulerTransform(frame.leftSaber), ConvertEulerTransform(frame.rightSaber)));
+        scoreData.scoreFrames.emplace_back(ScoreFrame(frame.time, frame.score, frame.percent, frame.combo, -1, 0));
+        replay->frames.Add(Frame(ConvertEulerTransform(frame.head), ConvertEulerTransform(frame.leftSaber), ConvertEulerTransform(frame.rightSaber)));
     }
     replay->info.score = frame.score;
 
@@ -133,8 +134,9 @@ ReplayWrapper ReadFromV1(std::ifstream& input) {
 
 // changed modifier order, added version header, added jump offset to keyframes
 ReplayWrapper ReadFromV2(std::ifstream& input) {
-    auto replay = new FrameReplay();
+    auto replay = new Replay();
     ReplayWrapper ret(ReplayType::Frame, replay);
+    auto& scoreData = replay->AddScoreData();
 
     auto modifiers = V2Modifiers();
     READ_TO(modifiers);
@@ -145,8 +147,8 @@ ReplayWrapper ReadFromV2(std::ifstream& input) {
     replay->info.hasYOffset = true;
     auto frame = V2KeyFrame();
     while(READ_TO(frame)) {
-        replay->scoreFrames.emplace_back(ScoreFrame(frame.time, frame.score, frame.percent, frame.combo, -1, frame.jumpYOffset));
-        replay->frames.emplace_back(Frame(ConvertEulerTransform(frame.head), ConvertEulerTransform(frame.leftSaber), ConvertEulerTransform(frame.rightSaber)));
+        scoreData.scoreFrames.emplace_back(ScoreFrame(frame.time, frame.score, frame.percent, frame.combo, -1, frame.jumpYOffset));
+        replay->frames.Add(Frame(ConvertEulerTransform(frame.head), ConvertEulerTransform(frame.leftSaber), ConvertEulerTransform(frame.rightSaber)));
     }
     replay->info.score = frame.score;
 
@@ -155,8 +157,9 @@ ReplayWrapper ReadFromV2(std::ifstream& input) {
 
 // added info for fails in replays (different from reaching 0 energy with no fail)
 ReplayWrapper ReadFromV3(std::ifstream& input) {
-    auto replay = new FrameReplay();
+    auto replay = new Replay();
     ReplayWrapper ret(ReplayType::Frame, replay);
+    auto& scoreData = replay->AddScoreData();
 
     READ_TO(replay->info.failed);
     READ_TO(replay->info.failTime);
@@ -169,8 +172,8 @@ ReplayWrapper ReadFromV3(std::ifstream& input) {
     replay->info.hasYOffset = true;
     auto frame = V2KeyFrame();
     while(READ_TO(frame)) {
-        replay->scoreFrames.emplace_back(ScoreFrame(frame.time, frame.score, frame.percent, frame.combo, -1, frame.jumpYOffset));
-        replay->frames.emplace_back(Frame(ConvertEulerTransform(frame.head), ConvertEulerTransform(frame.leftSaber), ConvertEulerTransform(frame.rightSaber)));
+        scoreData.scoreFrames.emplace_back(ScoreFrame(frame.time, frame.score, frame.percent, frame.combo, -1, frame.jumpYOffset));
+        replay->frames.Add(Frame(ConvertEulerTransform(frame.head), ConvertEulerTransform(frame.leftSaber), ConvertEulerTransform(frame.rightSaber)));
     }
     replay->info.score = frame.score;
 
@@ -179,8 +182,9 @@ ReplayWrapper ReadFromV3(std::ifstream& input) {
 
 // explicitly added reached 0 energy bool and time to the replay
 ReplayWrapper ReadFromV4(std::ifstream& input) {
-    auto replay = new FrameReplay();
+    auto replay = new Replay();
     ReplayWrapper ret(ReplayType::Frame, replay);
+    auto& scoreData = replay->AddScoreData();
 
     READ_TO(replay->info.failed);
     READ_TO(replay->info.failTime);
@@ -195,8 +199,8 @@ ReplayWrapper ReadFromV4(std::ifstream& input) {
     replay->info.hasYOffset = true;
     auto frame = V2KeyFrame();
     while(READ_TO(frame)) {
-        replay->scoreFrames.emplace_back(ScoreFrame(frame.time, frame.score, frame.percent, frame.combo, -1, frame.jumpYOffset));
-        replay->frames.emplace_back(Frame(ConvertEulerTransform(frame.head), ConvertEulerTransform(frame.leftSaber), ConvertEulerTransform(frame.rightSaber)));
+        scoreData.scoreFrames.emplace_back(ScoreFrame(frame.time, frame.score, frame.percent, frame.combo, -1, frame.jumpYOffset));
+        replay->frames.Add(Frame(ConvertEulerTransform(frame.head), ConvertEulerTransform(frame.leftSaber), ConvertEulerTransform(frame.rightSaber)));
     }
     replay->info.score = frame.score;
 
@@ -205,8 +209,9 @@ ReplayWrapper ReadFromV4(std::ifstream& input) {
 
 // added energy to keyframes
 ReplayWrapper ReadFromV5(std::ifstream& input) {
-    auto replay = new FrameReplay();
+    auto replay = new Replay();
     ReplayWrapper ret(ReplayType::Frame, replay);
+    auto& scoreData = replay->AddScoreData();
 
     READ_TO(replay->info.failed);
     READ_TO(replay->info.failTime);
@@ -221,8 +226,8 @@ ReplayWrapper ReadFromV5(std::ifstream& input) {
     replay->info.hasYOffset = true;
     auto frame = V5KeyFrame();
     while(READ_TO(frame)) {
-        replay->scoreFrames.emplace_back(ScoreFrame(frame.time, frame.score, frame.percent, frame.combo, frame.energy, frame.jumpYOffset));
-        replay->frames.emplace_back(Frame(ConvertEulerTransform(frame.head), ConvertEulerTransform(frame.leftSaber), ConvertEulerTransform(frame.rightSaber)));
+        scoreData.scoreFrames.emplace_back(ScoreFrame(frame.time, frame.score, frame.percent, frame.combo, frame.energy, frame.jumpYOffset));
+        replay->frames.Add(Frame(ConvertEulerTransform(frame.head), ConvertEulerTransform(frame.leftSaber), ConvertEulerTransform(frame.rightSaber)));
     }
     replay->info.score = frame.score;
 
@@ -231,8 +236,9 @@ ReplayWrapper ReadFromV5(std::ifstream& input) {
 
 // reordered modifiers again and added the new ones
 ReplayWrapper ReadFromV6(std::ifstream& input) {
-    auto replay = new FrameReplay();
+    auto replay = new Replay();
     ReplayWrapper ret(ReplayType::Frame, replay);
+    auto& scoreData = replay->AddScoreData();
 
     READ_TO(replay->info.failed);
     READ_TO(replay->info.failTime);
@@ -247,8 +253,8 @@ ReplayWrapper ReadFromV6(std::ifstream& input) {
     replay->info.hasYOffset = true;
     auto frame = V5KeyFrame();
     while(READ_TO(frame)) {
-        replay->scoreFrames.emplace_back(ScoreFrame(frame.time, frame.score, frame.percent, frame.combo, frame.energy, frame.jumpYOffset));
-        replay->frames.emplace_back(Frame(ConvertEulerTransform(frame.head), ConvertEulerTransform(frame.leftSaber), ConvertEulerTransform(frame.rightSaber)));
+        scoreData.scoreFrames.emplace_back(ScoreFrame(frame.time, frame.score, frame.percent, frame.combo, frame.energy, frame.jumpYOffset));
+        replay->frames.Add(Frame(ConvertEulerTransform(frame.head), ConvertEulerTransform(frame.leftSaber), ConvertEulerTransform(frame.rightSaber)));
     }
     replay->info.score = frame.score;
 
@@ -304,8 +310,8 @@ ReplayWrapper ReadReqlay(const std::string& path) {
     ret.replay->info.positionsAreLocal = false;
 
     QuaternionAverage averageCalc(UnityEngine::Quaternion::Euler({0, 0, 0}));
-    for(auto& frame : ret.replay->frames) {
-        averageCalc.AddRotation(frame.head.rotation);
+    for(auto& head : ret.replay->frames.Heads()) {
+        averageCalc.AddRotation(head.rotation);
     }
     ret.replay->info.averageOffset = UnityEngine::Quaternion::Inverse(averageCalc.GetAverage());
     if(path.find("Degree") != std::string::npos || path.find("degree") != std::string::npos) {
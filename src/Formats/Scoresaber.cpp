@@ -177,9 +177,12 @@ ReplayWrapper ReadScoresaber(const std::string& path) {
     }
     std::stringstream input;
     input.write(decompressed.data(), decompressed.size());
+    std::streampos end = decompressed.size();
 
-    auto replay = new EventFrame();
+    auto replay = new Replay();
     ReplayWrapper ret(ReplayType::Event | ReplayType::Frame, replay);
+    auto& eventData = replay->AddEventData();
+    auto& scoreData = replay->AddScoreData();
     auto& info = replay->info;
 
     SSPointers beginnings;
@@ -200,10 +203,15 @@ ReplayWrapper ReadScoresaber(const std::string& path) {
     input.seekg(beginnings.poseKeyframes);
     int count;
     READ_TO(count);
+    replay->frames.Reserve(ReserveCount(input, end, count, sizeof(VRPoseGroup)));
+    // the poses are most of the file and aren't stored in the arena
+    size_t posesSize = count * sizeof(VRPoseGroup);
+    if(decompressed.size() > posesSize)
+        replay->arena.SetSizeHint(2 * (decompressed.size() - posesSize));
     VRPoseGroup posFrame;
     for(int i = 0; i < count; i++) {
         READ_TO(posFrame);
-        replay->frames.emplace_back(posFrame.Time, posFrame.FPS, posFrame.Head, posFrame.Left, posFrame.Right);
+        replay->frames.Add(Frame(posFrame.Time, posFrame.FPS, posFrame.Head, posFrame.Left, posFrame.Right));
         averageCalc.AddRotation(posFrame.Head.rotation);
     }
     info.averageOffset = UnityEngine::Quaternion::Inverse(averageCalc.GetAverage());
@@ -215,17 +223,18 @@ ReplayWrapper ReadScoresaber(const std::string& path) {
 
     input.seekg(beginnings.heightKeyframes);
     READ_TO(count);
+    eventData.heights.reserve(ReserveCount(input, end, count, sizeof(HeightEvent)));
     for(int i = 0; i < count; i++) {
-        auto& height = replay->heights.emplace_back(HeightEvent());
+        auto& height = eventData.heights.emplace_back(HeightEvent());
         READ_TO(height);
-        replay->events.emplace(height.time, EventRef::Height, replay->heights.size() - 1);
     }
 
     input.seekg(beginnings.noteKeyframes);
     READ_TO(count);
+    eventData.notes.reserve(ReserveCount(input, end, count, sizeof(SSNoteEvent)));
     SSNoteEvent ssNote;
     for(int i = 0; i < count; i++) {
-        auto& note = replay->notes.emplace_back(NoteEvent());
+        auto& note = eventData.notes.emplace_back(NoteEvent());
         READ_TO(ssNote);
 
         note.time = ssNote.Time;
@@ -250,7 +259,6 @@ ReplayWrapper ReadScoresaber(const std::string& path) {
             note.noteCutInfo.beforeCutRating = ssNote.BeforeCutRating;
             note.noteCutInfo.afterCutRating = ssNote.AfterCutRating;
         }
-        replay->events.emplace(note.time, EventRef::Note, replay->notes.size() - 1);
     }
 
     std::map<float, ScoreFrame> framesMap = {};
@@ -295,13 +303,14 @@ ReplayWrapper ReadScoresaber(const std::string& path) {
             existing->second.energy = ssEnergy.Energy;
     }
     for(auto& [_, frame] : framesMap)
-        replay->scoreFrames.emplace_back(std::move(frame));
+        scoreData.scoreFrames.emplace_back(std::move(frame));
+    BuildTimeline(eventData);
 
     auto modified = std::filesystem::last_write_time(path);
     info.timestamp = std::filesystem::file_time_type::clock::to_time_t(modified);
     info.source = "ScoreSaber";
     info.positionsAreLocal = false;
-    replay->cutInfoMissingOKs = true;
+    eventData.cutInfoMissingOKs = true;
     // get player name somehow, player id seems to be in file name
     return ret;
 }
@@ -41,7 +41,7 @@ void Camera_PlayerTransformsUpdate_Pre(PlayerTransforms* self) {
         // head tranform IS the camera
         Vector3 targetPos;
         Quaternion targetRot;
-        if(Manager::GetCurrentInfo().positionsAreLocal || Manager::Camera::GetMode() == (int) CameraMode::ThirdPerson) {
+        if(Manager::GetPose().local || Manager::Camera::GetMode() == (int) CameraMode::ThirdPerson) {
             auto parent = self->originParentTransform ? self->originParentTransform : cameraRig->get_transform()->get_parent();
             auto rot = parent->get_rotation();
             targetPos = Sombrero::QuaternionMultiply(rot, Manager::Camera::GetHeadPosition()) + parent->get_position();
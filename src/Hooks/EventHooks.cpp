@@ -29,6 +29,8 @@ MAKE_HOOK_MATCH(BurstSliderGameNoteController_HandleCut, &BurstSliderGameNoteCon
 
 #include "GlobalNamespace/PlayerHeadAndObstacleInteraction.hpp"
 #include "GlobalNamespace/GameEnergyCounter.hpp"
+#include "GlobalNamespace/ScoreController.hpp"
+#include "GlobalNamespace/AudioTimeSyncController.hpp"
 #include "UnityEngine/Time.hpp"
 
 // disable real obstacle interactions
@@ -46,7 +48,9 @@ MAKE_HOOK_MATCH(GameEnergyCounter_LateUpdate, &GameEnergyCounter::LateUpdate, vo
     if(Manager::replaying && Manager::currentReplay.type & ReplayType::Event) {
         float& actualEnergyLoss = Manager::Events::wallEnergyLoss;
         if(actualEnergyLoss > 0) {
-            float gameEnergyLoss = UnityEngine::Time::get_deltaTime() * 1.3;
+            // in song time, so it keeps up with the events when fast forwarding
+            float timeScale = Manager::Objects::scoreController->audioTimeSyncController->timeScale;
+            float gameEnergyLoss = UnityEngine::Time::get_deltaTime() * timeScale * 1.3;
             if(gameEnergyLoss >= actualEnergyLoss) {
                 self->ProcessEnergyChange(-actualEnergyLoss);
                 actualEnergyLoss = 0;
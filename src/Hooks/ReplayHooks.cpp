@@ -88,28 +88,14 @@ MAKE_HOOK_MATCH(Saber_ManualUpdate, &Saber::ManualUpdate, void, Saber* self) {
         auto saberTransform = self->get_transform()->GetParent();
         int saberType = (int) self->get_saberType();
 
-        const Transform *transform, *nextTransform = nullptr;
-        if(saberType == 0) {
-            transform = &Manager::GetFrame().leftHand;
-            if(Manager::GetFrameProgress() > 0)
-                nextTransform = &Manager::GetNextFrame().leftHand;
+        auto& pose = Manager::GetPose();
+        auto& transform = saberType == 0 ? pose.leftHand : pose.rightHand;
+        if(pose.local) {
+            saberTransform->set_localRotation(transform.rotation);
+            saberTransform->set_localPosition(transform.position);
         } else {
-            transform = &Manager::GetFrame().rightHand;
-            if(Manager::GetFrameProgress() > 0)
-                nextTransform = &Manager::GetNextFrame().rightHand;
-        }
-        Quaternion rot = transform->rotation;
-        Vector3 pos = transform->position;
-        if(nextTransform) {
-            rot = Quaternion::Lerp(rot, nextTransform->rotation, Manager::GetFrameProgress());
-            pos = Vector3::Lerp(pos, nextTransform->position, Manager::GetFrameProgress());
-        }
-        if(Manager::GetCurrentInfo().positionsAreLocal) {
-            saberTransform->set_localRotation(rot);
-            saberTransform->set_localPosition(pos);
-        } else {
-            saberTransform->set_rotation(rot);
-            saberTransform->set_position(pos);
+            saberTransform->set_rotation(transform.rotation);
+            saberTransform->set_position(transform.position);
         }
     }
     Saber_ManualUpdate(self);
@@ -122,12 +108,12 @@ MAKE_HOOK_MATCH(Saber_ManualUpdate, &Saber::ManualUpdate, void, Saber* self) {
 void Replay_PlayerTransformsUpdate_Post(PlayerTransforms* self) {
     if(!Manager::replaying)
         return;
-    auto& transform = Manager::GetFrame();
-    auto targetRot = transform.head.rotation;
-    auto targetPos = transform.head.position;
+    auto& pose = Manager::GetPose();
+    auto targetRot = pose.head.rotation;
+    auto targetPos = pose.head.position;
     auto originParent = self->originParentTransform;
     // both world pos and pseudo local pos are used in other places
-    if(Manager::GetCurrentInfo().positionsAreLocal) {
+    if(pose.local) {
         self->headPseudoLocalRot = targetRot;
         self->headPseudoLocalPos = targetPos;
         if(originParent) {
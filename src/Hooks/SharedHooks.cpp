@@ -9,9 +9,9 @@
 using namespace GlobalNamespace;
 
 #include "GlobalNamespace/ScoreController.hpp"
-#include "CustomTypes/ScoringElement.hpp"
+#include "GlobalNamespace/ScoringElement.hpp"
 
-// override max score in frame replays and prevent crashing on attempting to despawn fake scoring elements from event replays
+// override max score in frame replays
 MAKE_HOOK_MATCH(ScoreController_DespawnScoringElement, &ScoreController::DespawnScoringElement, void, ScoreController* self, ScoringElement* scoringElement) {
 
     if(Manager::replaying && Manager::currentReplay.type & ReplayType::Frame && Manager::Frames::AllowScoreOverride()) {
@@ -21,9 +21,6 @@ MAKE_HOOK_MATCH(ScoreController_DespawnScoringElement, &ScoreController::Despawn
         if(frame->percent > 0)
             self->immediateMaxPossibleMultipliedScore = frame->score / frame->percent;
     }
-    if(il2cpp_utils::try_cast<ReplayHelpers::ScoringElement>(scoringElement))
-        return;
-
     ScoreController_DespawnScoringElement(self, scoringElement);
 }
 
@@ -52,28 +49,47 @@ MAKE_HOOK_MATCH(NoteController_HandleNoteDidPassMissedMarkerEvent, &NoteControll
 }
 
 #include "GlobalNamespace/AudioTimeSyncController.hpp"
-#include "UnityEngine/Time.hpp"
 
 // keep song time and current frame up to date, plus controller inputs, and delay ending of renders
 MAKE_HOOK_MATCH(AudioTimeSyncController_Update, &AudioTimeSyncController::Update, void, AudioTimeSyncController* self) {
 
     if(Manager::replaying && !Manager::paused) {
-        Manager::UpdateTime(self->songTime);
+        if(!Manager::scrubbing)
+            Manager::UpdateTime(self->songTime);
         Manager::CheckInputs();
     }
+    // stop the controller from syncing to the audio when the replay clock sets the time instead
     int state = self->state;
-    if(Manager::replaying && Manager::Camera::rendering && !Manager::Camera::GetAudioMode())
+    if(Manager::ClockDrivesSong())
         self->state = AudioTimeSyncController::State::Stopped;
 
     AudioTimeSyncController_Update(self);
 
-    // remove min check
-    if(Manager::replaying && Manager::Camera::rendering && !Manager::Camera::GetAudioMode()) {
-		self->lastFrameDeltaSongTime = UnityEngine::Time::get_deltaTime() * self->timeScale;
-        self->songTime += self->lastFrameDeltaSongTime;
-        self->isReady = true;
-    }
     self->state = state;
+    Manager::UpdateClock(self);
+}
+
+#include "GlobalNamespace/NoteCutSoundEffectManager.hpp"
+
+// no cut sounds when fast forwarding, since they can't be sped up with the song
+MAKE_HOOK_MATCH(NoteCutSoundEffectManager_HandleNoteWasSpawned, &NoteCutSoundEffectManager::HandleNoteWasSpawned, void, NoteCutSoundEffectManager* self, NoteController* noteController) {
+
+    if(Manager::replaying && Manager::fastForwarding)
+        return;
+
+    NoteCutSoundEffectManager_HandleNoteWasSpawned(self, noteController);
+}
+
+#include "GlobalNamespace/NoteCutCoreEffectsSpawner.hpp"
+#include "GlobalNamespace/NoteCutInfo.hpp"
+
+// or cut effects, which would pile up
+MAKE_HOOK_MATCH(NoteCutCoreEffectsSpawner_HandleNoteWasCut, &NoteCutCoreEffectsSpawner::HandleNoteWasCut, void, NoteCutCoreEffectsSpawner* self, NoteController* noteController, ByRef<NoteCutInfo> noteCutInfo) {
+
+    if(Manager::replaying && Manager::fastForwarding)
+        return;
+
+    NoteCutCoreEffectsSpawner_HandleNoteWasCut(self, noteController, noteCutInfo);
 }
 
 #include "GlobalNamespace/PlayerTransforms.hpp"
@@ -115,6 +131,8 @@ HOOK_FUNC(
     INSTALL_HOOK(logger, NoteController_HandleNoteDidPassMissedMarkerEvent);
     // general and camera
     INSTALL_HOOK(logger, AudioTimeSyncController_Update);
+    INSTALL_HOOK(logger, NoteCutSoundEffectManager_HandleNoteWasSpawned);
+    INSTALL_HOOK(logger, NoteCutCoreEffectsSpawner_HandleNoteWasCut);
     INSTALL_HOOK(logger, PlayerTransforms_Update);
     INSTALL_HOOK(logger, PauseMenuManager_ShowMenu);
     INSTALL_HOOK(logger, PauseMenuManager_HandleResumeFromPauseAnimationDidFinish);
@@ -0,0 +1,77 @@
+#include "Main.hpp"
+#include "LevelKeys.hpp"
+
+#include "GlobalNamespace/IPreviewBeatmapLevel.hpp"
+#include "GlobalNamespace/IDifficultyBeatmap.hpp"
+#include "GlobalNamespace/IDifficultyBeatmapSet.hpp"
+#include "GlobalNamespace/BeatmapDifficulty.hpp"
+#include "GlobalNamespace/BeatmapDifficultySerializedMethods.hpp"
+#include "GlobalNamespace/BeatmapCharacteristicSO.hpp"
+
+#include <unordered_map>
+
+using namespace GlobalNamespace;
+
+LevelKeys MakeLevelKeys(const std::string& levelID, const std::string& songName) {
+    LevelKeys ret;
+    ret.levelID = levelID;
+    ret.songName = songName;
+    // should be in all songloader levels
+    bool custom = levelID.starts_with("custom_level_");
+    ret.bsorHash = custom ? levelID.substr(13) : levelID;
+    ret.hash = ret.bsorHash;
+    std::transform(ret.hash.begin(), ret.hash.end(), ret.hash.begin(), tolower);
+    ret.ssHash = custom ? ret.bsorHash : "ost_" + levelID;
+    return ret;
+}
+
+// levels can be recreated at the same address after a song refresh, so the id string is kept to check against
+struct CachedLevelKeys {
+    Il2CppString* id;
+    LevelKeys keys;
+};
+
+struct CachedDifficultyKeys {
+    IPreviewBeatmapLevel* level;
+    Il2CppString* id;
+    DifficultyKeys keys;
+};
+
+// only used from the main thread
+std::unordered_map<IPreviewBeatmapLevel*, CachedLevelKeys> levelKeys;
+std::unordered_map<IDifficultyBeatmap*, CachedDifficultyKeys> difficultyKeys;
+
+const LevelKeys& GetLevelKeys(IPreviewBeatmapLevel* level) {
+    Il2CppString* id = level->get_levelID();
+    auto existing = levelKeys.find(level);
+    if(existing != levelKeys.end() && existing->second.id == id)
+        return existing->second.keys;
+    auto& cached = levelKeys[level];
+    cached.id = id;
+    cached.keys = MakeLevelKeys(level->get_levelID(), level->get_songName());
+    return cached.keys;
+}
+
+const DifficultyKeys& GetDifficultyKeys(IDifficultyBeatmap* beatmap) {
+    auto level = (IPreviewBeatmapLevel*) beatmap->get_level();
+    Il2CppString* id = level->get_levelID();
+    auto existing = difficultyKeys.find(beatmap);
+    if(existing != difficultyKeys.end() && existing->second.level == level && existing->second.id == id)
+        return existing->second.keys;
+
+    auto& keys = GetLevelKeys(level);
+    auto characteristic = beatmap->get_parentDifficultyBeatmapSet()->get_beatmapCharacteristic();
+    std::string diffName = BeatmapDifficultySerializedMethods::SerializedName(beatmap->get_difficulty());
+    std::string serializedName = characteristic->serializedName;
+    std::string compoundName = characteristic->compoundIdPartName;
+
+    auto& cached = difficultyKeys[beatmap];
+    cached.level = level;
+    cached.id = id;
+    cached.keys.reqlayName = keys.hash + std::to_string((int) beatmap->get_difficulty()) + compoundName;
+    cached.keys.ssEnding = fmt::format("-{}-{}-{}-{}", keys.songName, diffName, serializedName, keys.ssHash);
+    if(diffName == "Unknown")
+        diffName = "Error";
+    cached.keys.bsorSearch = fmt::format("{}-{}-{}", diffName, serializedName, keys.bsorHash);
+    return cached.keys;
+}
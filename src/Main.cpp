@@ -4,6 +4,7 @@
 #include "CustomTypes/ReplayMenu.hpp"
 #include "Hooks.hpp"
 #include "ReplayManager.hpp"
+#include "ReplayIndex.hpp"
 #include "Utils.hpp"
 #include "CustomTypes/ReplaySettings.hpp"
 
@@ -26,6 +27,18 @@ MAKE_HOOK_MATCH(StandardLevelDetailView_RefreshContent, &StandardLevelDetailView
     Menu::CheckMultiplayer();
 }
 
+#include "GlobalNamespace/LevelCollectionViewController.hpp"
+
+MAKE_HOOK_MATCH(LevelCollectionViewController_HandleLevelCollectionTableViewDidSelectLevel, &LevelCollectionViewController::HandleLevelCollectionTableViewDidSelectLevel,
+        void, LevelCollectionViewController* self, LevelCollectionTableView* tableView, IPreviewBeatmapLevel* level) {
+
+    // start loading replays before the detail view has finished loading the level
+    if(level && !Manager::replaying)
+        Index::Prefetch(GetLevelKeys(level));
+
+    LevelCollectionViewController_HandleLevelCollectionTableViewDidSelectLevel(self, tableView, level);
+}
+
 #include "GlobalNamespace/SinglePlayerLevelSelectionFlowCoordinator.hpp"
 #include "HMUI/ViewController_AnimationType.hpp"
 #include "HMUI/ViewController_AnimationDirection.hpp"
@@ -108,6 +121,7 @@ extern "C" void load() {
     auto& logger = getLogger();
     Hooks::Install(logger);
     INSTALL_HOOK(logger, StandardLevelDetailView_RefreshContent);
+    INSTALL_HOOK(logger, LevelCollectionViewController_HandleLevelCollectionTableViewDidSelectLevel);
     INSTALL_HOOK(logger, SinglePlayerLevelSelectionFlowCoordinator_LevelSelectionFlowCoordinatorTopViewControllerWillChange);
     INSTALL_HOOK(logger, SinglePlayerLevelSelectionFlowCoordinator_BackButtonWasPressed);
     INSTALL_HOOK(logger, LevelFilteringNavigationController_UpdateCustomSongs);
@@ -121,4 +135,6 @@ extern "C" void load() {
         recorderInstalled = true;
 
     LOG_INFO("Recording mod installed: {}", recorderInstalled);
+
+    Index::StartIndexing();
 }
@@ -138,14 +138,17 @@ void RenderCurrentLevel() {
     auto map = levelSelection->get_selectedDifficultyBeatmap();
     if(!map)
         return;
-    auto replays = GetReplays(map);
-    if(replays.empty())
+    // the menu has usually loaded the replays for this map already
+    auto replays = Manager::GetLevelReplays();
+    if(!replays || Manager::beatmap != map)
+        replays = std::make_shared<const ReplayList>(GetReplays(map));
+    if(replays->empty())
         return;
     Manager::Camera::rendering = true;
     int idx = getConfig().LastReplayIdx.GetValue();
-    if(idx >= replays.size())
-        idx = replays.size() - 1;
-    Manager::ReplayStarted(replays[idx].second);
+    if(idx >= replays->size())
+        idx = replays->size() - 1;
+    Manager::ReplayStarted((*replays)[idx].second);
     levelSelection->StartLevel(nullptr, false);
 }
 
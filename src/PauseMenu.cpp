@@ -6,16 +6,14 @@
 #include "Formats/FrameReplay.hpp"
 #include "Formats/EventReplay.hpp"
 
-#include "CustomTypes/ScoringElement.hpp"
-
 #include "GlobalNamespace/SharedCoroutineStarter.hpp"
 #include "GlobalNamespace/ScoreController.hpp"
+#include "GlobalNamespace/ScoreMultiplierCounter.hpp"
 #include "GlobalNamespace/AudioTimeSyncController_InitData.hpp"
 #include "GlobalNamespace/GameEnergyCounter.hpp"
 #include "GlobalNamespace/ComboController.hpp"
 #include "GlobalNamespace/NoteCutInfo.hpp"
 #include "GlobalNamespace/PlayerHeadAndObstacleInteraction.hpp"
-#include "GlobalNamespace/ListExtensions.hpp"
 #include "GlobalNamespace/BeatmapObjectManager.hpp"
 #include "GlobalNamespace/NoteCutSoundEffectManager.hpp"
 #include "GlobalNamespace/MemoryPoolContainer_1.hpp"
@@ -39,16 +37,13 @@
 
 #include "questui/shared/BeatSaberUI.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace GlobalNamespace;
 using namespace QuestUI;
 using namespace Manager::Objects;
 
-void InsertIntoSortedListFromEnd(List<ScoringElement*>* sortedList, ScoringElement* newItem) {
-    static auto* ___internal__method = il2cpp_utils::FindMethodUnsafe("", "ListExtensions", "InsertIntoSortedListFromEnd", 2);
-    static auto* ___generic__method = THROW_UNLESS(il2cpp_utils::MakeGenericMethod(___internal__method, std::vector<Il2CppClass*>{classof(ScoringElement*)}));
-    il2cpp_utils::RunMethodRethrow<void, false>(nullptr, ___generic__method, sortedList, newItem);
-}
-
 void DespawnObject(BeatmapObjectManager* manager, IBeatmapObjectController* object) {
     object->Pause(false);
     if(il2cpp_utils::try_cast<NoteController>(object).has_value())
@@ -157,16 +152,57 @@ namespace Pause {
         parent->SetActive(Manager::replaying);
     }
 
+    void StopCutSounds() {
+        auto sounds = noteSoundManager->noteCutSoundEffectPoolContainer->get_activeItems();
+        for(int i = 0; i < sounds->get_Count(); i++)
+            sounds->get_Item(i)->StopPlayingAndFinish();
+    }
+
+    // audio pitch can't be adjusted past 2 for some reason, so faster speeds are silent
+    const float maxPitchSpeed = 2;
+    const float maxSpeed = 16;
+    float fastForwardVolume = 1;
+
+    float StepSpeed(float speed, int direction) {
+        // fast forward speeds double instead of going up by a tenth
+        if(direction > 0 && speed >= maxPitchSpeed - 0.01)
+            return speed * 2;
+        if(direction < 0 && speed > maxPitchSpeed + 0.01)
+            return speed / 2;
+        return speed + direction * 0.1;
+    }
+
     void SetSpeed(float speed) {
         auto audio = scoreController->audioTimeSyncController;
-        // audio pitch can't be adjusted past these for some reason
-        if(speed > 2)
-            speed = 2;
-        if(speed < 0.5)
-            speed = 0.5;
+        // renders need the audio clock or a fixed step, so they can't fast forward
+        if(speed > maxPitchSpeed && Manager::Camera::rendering)
+            speed = maxPitchSpeed;
+        // float steps land slightly off, so snap to a tenth, or to a doubling when fast forwarding
+        bool fastForward = speed > maxPitchSpeed + 0.01;
+        if(fastForward)
+            speed = std::clamp(std::exp2(std::round(std::log2(speed))), maxPitchSpeed * 2, maxSpeed);
+        else
+            speed = std::clamp(std::round(speed * 10) / 10, 0.5f, maxPitchSpeed);
         audio->timeScale = speed;
+
+        if(fastForward) {
+            if(!Manager::fastForwarding) {
+                fastForwardVolume = audio->audioSource->get_volume();
+                audio->audioSource->set_volume(0);
+                StopCutSounds();
+                Manager::SetFastForward(true);
+            }
+            return;
+        }
         audio->audioSource->set_pitch(speed);
         audioManager->set_musicPitch(1 / speed);
+        if(Manager::fastForwarding) {
+            Manager::SetFastForward(false);
+            // the audio was left behind, so move it back to the song
+            audio->SeekTo((audio->songTime - audio->startSongTime) / speed);
+            audio->audioSource->set_volume(fastForwardVolume);
+            return;
+        }
         audio->audioStartTimeOffsetSinceStart = (UnityEngine::Time::get_timeSinceLevelLoad() * speed) - (audio->songTime + audio->initData->songTimeOffset);
     }
 
@@ -195,8 +231,7 @@ namespace Pause {
         gameEnergyCounter->energyType = energyType;
     }
 
-    void PreviewTime(float time) {
-        touchedTime = true;
+    void PreviewScore(float time) {
         auto values = MapAtTime(Manager::currentReplay, time);
         float modifierMult = ModifierMultiplier(Manager::currentReplay, values.energy == 0);
         gameEnergyCounter->energy = values.energy;
@@ -219,10 +254,13 @@ namespace Pause {
         il2cpp_utils::RunMethodUnsafe(comboController, "HandleNoteWasCut", nullptr, byref(goodCut));
     }
 
+    void PreviewTime(float time) {
+        touchedTime = true;
+        PreviewScore(time);
+    }
+
     void DespawnObjects() {
-        auto sounds = noteSoundManager->noteCutSoundEffectPoolContainer->get_activeItems();
-        for(int i = 0; i < sounds->get_Count(); i++)
-            sounds->get_Item(i)->StopPlayingAndFinish();
+        StopCutSounds();
         noteSoundManager->prevNoteATime = -1;
         noteSoundManager->prevNoteBTime = -1;
         auto objects = beatmapObjectManager->allBeatmapObjects;
@@ -260,85 +298,46 @@ namespace Pause {
             scoreController->scoringElementsWithMultiplier->get_Item(i)->SetMultipliers(0, 0);
     }
 
-    void UpdateScoreController() {
-        // literally the exact implementation of ScoreController::LateUpdate
-        auto& self = scoreController;
-        // Get the time of the next note that should be scored, or a large value if there are no more notes.
-        float num = self->sortedNoteTimesWithoutScoringElements->get_Count() > 0 ? self->sortedNoteTimesWithoutScoringElements->get_Item(0) : 3000000000;
-        // Get the current game time, plus a small offset.
-        float num2 = self->audioTimeSyncController->get_songTime() + 0.15;
-        // A counter for the number of scoring elements that have been processed.
-        int num3 = 0;
-        // A flag indicating whether the score multiplier has changed.
-        bool flag = false;
-        for(int i = 0; i < self->sortedScoringElementsWithoutMultiplier->get_Count(); i++) {
-            auto item = self->sortedScoringElementsWithoutMultiplier->get_Item(i);
-            // If the element's time is outside of the range of the current game time and the next note's time,
-            // process the element's multiplier event and add it to the list of scoring elements with multipliers.
-            if(item->get_time() < num2 || item->get_time() > num) {
-                // Process the multiplier event for the element.
-                flag |= self->scoreMultiplierCounter->ProcessMultiplierEvent(item->get_multiplierEventType());
-                // If the element would have given a positive multiplier, also process it for the maximum score multiplier counter.
-                if(item->get_wouldBeCorrectCutBestPossibleMultiplierEventType() == ScoreMultiplierCounter::MultiplierEventType::Positive)
-                    self->maxScoreMultiplierCounter->ProcessMultiplierEvent(ScoreMultiplierCounter::MultiplierEventType::Positive);
-                item->SetMultipliers(self->scoreMultiplierCounter->get_multiplier(), self->maxScoreMultiplierCounter->get_multiplier());
-                self->scoringElementsWithMultiplier->Add(item);
-                // Increment the counter for processed elements.
-                num3++;
-                // Skip to the next element.
-                continue;
-            }
-            // If the element's time is within the range of the current game time and the next note's time,
-            // stop processing elements.
-            break;
-        }
-        // Remove the processed elements from the list of scoring elements without multipliers.
-        self->sortedScoringElementsWithoutMultiplier->RemoveRange(0, num3);
-        // If the score multiplier has changed, invoke the appropriate event.
-        if(flag)
-            self->multiplierDidChangeEvent->Invoke(self->scoreMultiplierCounter->get_multiplier(), self->scoreMultiplierCounter->get_normalizedProgress());
-        // A flag indicating whether the score has changed.
-        bool flag2 = false;
-        self->scoringElementsToRemove->Clear();
-        for(int i = 0; i < self->scoringElementsWithMultiplier->get_Count(); i++) {
-            auto item2 = self->scoringElementsWithMultiplier->get_Item(i);
-            // If the element is finished, add it to the list of elements to remove and add its score
-            // to the current multiplied and modified scores.
-            if (item2->get_isFinished()) {
-                // If the element has a positive maximum possible cut score, set the flag indicating that
-                // the score has changed and add the element's score to the current multiplied and modified scores.
-                if (item2->get_maxPossibleCutScore() > 0) {
-                    flag2 = true;
-                    self->multipliedScore += item2->get_cutScore() * item2->get_multiplier();
-                    self->immediateMaxPossibleMultipliedScore += item2->get_maxPossibleCutScore() * item2->get_maxMultiplier();
-                }
-                self->scoringElementsToRemove->Add(item2);
-                if(self->scoringForNoteFinishedEvent)
-                    self->scoringForNoteFinishedEvent->Invoke(item2);
-            }
-        }
-        for(int i = 0; i < self->scoringElementsToRemove->get_Count(); i++) {
-            auto item3 = self->scoringElementsToRemove->get_Item(i);
-            self->DespawnScoringElement(item3);
-            self->scoringElementsWithMultiplier->Remove(item3);
-        }
-        self->scoringElementsToRemove->Clear();
-        float totalMultiplier = self->gameplayModifiersModel->GetTotalMultiplier(self->gameplayModifierParams, self->gameEnergyCounter->get_energy());
-        // If the total multiplier has changed, set the flag indicating that the score has changed.
-        if (self->prevMultiplierFromModifiers != totalMultiplier) {
-            self->prevMultiplierFromModifiers = totalMultiplier;
-            flag2 = true;
-        }
-        // If the score has changed, update the current multiplied and modified scores and invoke the appropriate event.
-        if (flag2) {
-            self->modifiedScore = ScoreModel::GetModifiedScoreForGameplayModifiersScoreMultiplier(self->multipliedScore, totalMultiplier);
-            self->immediateMaxPossibleModifiedScore = ScoreModel::GetModifiedScoreForGameplayModifiersScoreMultiplier(self->immediateMaxPossibleMultipliedScore, totalMultiplier);
-            if(self->scoreDidChangeEvent)
-                self->scoreDidChangeEvent->Invoke(self->multipliedScore, self->modifiedScore);
-        }
+    void RestoreScoreState(const ScoreState& state) {
+        gameEnergyCounter->energy = state.energy;
+        gameEnergyCounter->ProcessEnergyChange(0);
+        if(state.energy > 0 && !energyBar->energyBar->get_enabled())
+            ResetEnergyBar();
+        if(energyBar->get_isActiveAndEnabled())
+            energyBar->RefreshEnergyUI(state.energy);
+
+        auto multiplierCounter = scoreController->scoreMultiplierCounter;
+        multiplierCounter->multiplier = state.multiplier;
+        multiplierCounter->multiplierIncreaseProgress = state.multiplierProgress;
+        multiplierCounter->multiplierIncreaseMaxProgress = state.multiplier * 2;
+        auto maxMultiplierCounter = scoreController->maxScoreMultiplierCounter;
+        maxMultiplierCounter->multiplier = state.maxMultiplier;
+        maxMultiplierCounter->multiplierIncreaseProgress = state.maxMultiplierProgress;
+        maxMultiplierCounter->multiplierIncreaseMaxProgress = state.maxMultiplier * 2;
+        scoreController->multiplierDidChangeEvent->Invoke(multiplierCounter->get_multiplier(), multiplierCounter->get_normalizedProgress());
+
+        float totalMultiplier = scoreController->gameplayModifiersModel->GetTotalMultiplier(scoreController->gameplayModifierParams, state.energy);
+        scoreController->prevMultiplierFromModifiers = totalMultiplier;
+        scoreController->multipliedScore = state.score;
+        scoreController->immediateMaxPossibleMultipliedScore = state.maxScore;
+        scoreController->modifiedScore = ScoreModel::GetModifiedScoreForGameplayModifiersScoreMultiplier(state.score, totalMultiplier);
+        scoreController->immediateMaxPossibleModifiedScore = ScoreModel::GetModifiedScoreForGameplayModifiersScoreMultiplier(state.maxScore, totalMultiplier);
+        if(state.maxScore == 0)
+            scoreController->immediateMaxPossibleModifiedScore = 1;
+        if(scoreController->scoreDidChangeEvent)
+            scoreController->scoreDidChangeEvent->Invoke(scoreController->multipliedScore, scoreController->modifiedScore);
+
+        // the combo event can't be invoked directly, so set it one below and let a good cut raise it
+        comboController->combo = state.combo - 1;
+        comboController->maxCombo = state.maxCombo;
+        NoteCutInfo goodCut{}; goodCut.speedOK = goodCut.directionOK = goodCut.saberTypeOK = true; goodCut.wasCutTooSoon = false;
+        il2cpp_utils::RunMethodUnsafe(comboController, "HandleNoteWasCut", nullptr, byref(goodCut));
+
+        if(state.recentNoteTime >= 0)
+            Manager::SetLastCutTime(state.recentNoteTime);
     }
 
-    void SetTime(float time) {
+    float ClampTime(float time) {
         float startTime = scoreController->audioTimeSyncController->startSongTime;
         float endTime = scoreController->audioTimeSyncController->get_songLength();
         auto& info = Manager::GetCurrentInfo();
@@ -350,60 +349,30 @@ namespace Pause {
             time = startTime;
         if(time > endTime)
             time = endTime;
+        return time;
+    }
+
+    void SetTime(float time) {
+        time = ClampTime(time);
         LOG_INFO("Time set to {}", time);
         DespawnObjects();
         ResetControllers();
         callbackController->startFilterTime = time;
         Manager::ReplayRestarted(false);
+        auto& replay = Manager::currentReplay;
+        std::optional<ScoreState> state;
+        if(replay.type & ReplayType::Event) {
+            // restore the simulated state all at once instead of replaying every event into the game
+            state = ScoreStateAtTime(replay, time);
+            Manager::Events::SkipTo(time);
+        }
         Manager::UpdateTime(time);
         float controllerTime = (time - scoreController->audioTimeSyncController->startSongTime) / scoreController->audioTimeSyncController->timeScale;
         scoreController->audioTimeSyncController->SeekTo(controllerTime);
-        auto& replay = Manager::currentReplay;
-        if(replay.type & ReplayType::Event) {
+        if(state) {
             // reset energy as we will override it
             Manager::Events::wallEnergyLoss = 0;
-            auto eventReplay = dynamic_cast<EventReplay*>(replay.replay.get());
-            float lastCalculatedWall = 0, wallEnd = 0;
-            // simulate all events
-            for(auto& event: eventReplay->events) {
-                if(event.time > time)
-                    break;
-                if(gameEnergyCounter->didReach0Energy && !eventReplay->info.modifiers.noFail)
-                    break;
-                // add wall energy change since last event
-                // needs to be done before the new event is processed in case it is a new wall
-                if(lastCalculatedWall != wallEnd) {
-                    if(event.time < wallEnd) {
-                        gameEnergyCounter->ProcessEnergyChange(1.3 * (lastCalculatedWall - event.time));
-                        lastCalculatedWall = event.time;
-                    } else {
-                        gameEnergyCounter->ProcessEnergyChange(1.3 * (lastCalculatedWall - wallEnd));
-                        lastCalculatedWall = wallEnd;
-                    }
-                }
-                switch(event.eventType) {
-                case EventRef::Note: {
-                    Manager::SetLastCutTime(event.time);
-                    auto& noteEvent = eventReplay->notes[event.index];
-                    auto scoringElement = MakeFakeScoringElement(noteEvent);
-                    InsertIntoSortedListFromEnd(scoreController->sortedScoringElementsWithoutMultiplier, scoringElement);
-                    UpdateScoreController();
-                    auto noteCutInfo = GetNoteCutInfo(nullptr, nullptr, noteEvent.noteCutInfo);
-                    il2cpp_utils::RunMethodUnsafe(comboController, "HandleNoteWasCut", nullptr, byref(noteCutInfo));
-                    gameEnergyCounter->ProcessEnergyChange(EnergyForNote(noteEvent.info));
-                    break;
-                } case EventRef::Wall:
-                    // combo doesn't get set back to 0 if you enter a wall while inside of one
-                    if(event.time > wallEnd)
-                        scoreController->playerHeadAndObstacleInteraction->headDidEnterObstaclesEvent->Invoke();
-                    // step through wall energy loss instead of doing it all at once
-                    lastCalculatedWall = event.time;
-                    wallEnd = std::max(wallEnd, eventReplay->walls[event.index].endTime);
-                    break;
-                default:
-                    break;
-                }
-            }
+            RestoreScoreState(*state);
         }
         if(replay.type & ReplayType::Frame) {
             // let hooks update values
@@ -425,4 +394,22 @@ namespace Pause {
             NoteCutInfo info{}; il2cpp_utils::RunMethodUnsafe(comboController, "HandleNoteWasCut", nullptr, byref(info));
         }
     }
+
+    void StartScrub() {
+        LOG_INFO("Started scrubbing");
+        // objects can't move backwards, so hide them until the time is set for real
+        scoreController->audioTimeSyncController->Pause();
+        DespawnObjects();
+    }
+
+    void PreviewScrub(float time) {
+        PreviewScore(time);
+    }
+
+    void EndScrub(float time) {
+        SetTime(time);
+        // seeking keeps the audio paused, and the pause menu resumes it itself
+        if(!Manager::paused)
+            scoreController->audioTimeSyncController->Resume();
+    }
 }
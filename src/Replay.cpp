@@ -0,0 +1,243 @@
+#include "Replay.hpp"
+#include "Formats/EventReplay.hpp"
+#include "Formats/FrameReplay.hpp"
+#include "MathUtils.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+const size_t blockSize = 64;
+const float componentRange = M_SQRT1_2;
+const uint32_t componentMax = (1 << 10) - 1;
+
+void FrameStore::Add(const Frame& frame) {
+    times.emplace_back(frame.time);
+    fps.emplace_back(frame.fps);
+    heads.emplace_back(frame.head);
+    leftHands.emplace_back(frame.leftHand);
+    rightHands.emplace_back(frame.rightHand);
+}
+
+void FrameStore::Reserve(size_t count) {
+    times.reserve(count);
+    fps.reserve(count);
+    heads.reserve(count);
+    leftHands.reserve(count);
+    rightHands.reserve(count);
+}
+
+void FrameStore::Erase(size_t begin, size_t end) {
+    times.erase(times.begin() + begin, times.begin() + end);
+    fps.erase(fps.begin() + begin, fps.begin() + end);
+    heads.erase(heads.begin() + begin, heads.begin() + end);
+    leftHands.erase(leftHands.begin() + begin, leftHands.begin() + end);
+    rightHands.erase(rightHands.begin() + begin, rightHands.begin() + end);
+}
+
+uint32_t PackRotation(const Quaternion& rotation) {
+    float components[4] = {rotation.x, rotation.y, rotation.z, rotation.w};
+    int largest = 0;
+    for(int i = 1; i < 4; i++) {
+        if(std::abs(components[i]) > std::abs(components[largest]))
+            largest = i;
+    }
+    // q and -q are the same rotation, so the largest component can always be made positive
+    float sign = components[largest] < 0 ? -1 : 1;
+    uint32_t ret = largest << 30;
+    int shift = 20;
+    for(int i = 0; i < 4; i++) {
+        if(i == largest)
+            continue;
+        float normalized = (components[i] * sign / componentRange + 1) / 2;
+        auto quantized = (uint32_t) std::clamp(std::lround(normalized * componentMax), 0l, (long) componentMax);
+        ret |= quantized << shift;
+        shift -= 10;
+    }
+    return ret;
+}
+
+Quaternion UnpackRotation(uint32_t packed) {
+    int largest = packed >> 30;
+    float components[4];
+    float sum = 0;
+    int shift = 20;
+    for(int i = 0; i < 4; i++) {
+        if(i == largest)
+            continue;
+        float normalized = ((packed >> shift) & componentMax) / (float) componentMax;
+        components[i] = (normalized * 2 - 1) * componentRange;
+        sum += components[i] * components[i];
+        shift -= 10;
+    }
+    components[largest] = std::sqrt(std::max(0.0f, 1 - sum));
+    return Quaternion(components[0], components[1], components[2], components[3]);
+}
+
+void FrameStore::Pack(std::vector<Transform>& transforms, PackedTrack& track) {
+    track.positions.reserve(transforms.size());
+    track.rotations.reserve(transforms.size());
+    for(size_t start = 0; start < transforms.size(); start += blockSize) {
+        size_t end = std::min(start + blockSize, transforms.size());
+        Vector3 min = transforms[start].position;
+        Vector3 max = min;
+        for(size_t i = start + 1; i < end; i++) {
+            auto& position = transforms[i].position;
+            min = Vector3(std::min(min.x, position.x), std::min(min.y, position.y), std::min(min.z, position.z));
+            max = Vector3(std::max(max.x, position.x), std::max(max.y, position.y), std::max(max.z, position.z));
+        }
+        Vector3 origin = (min + max) * 0.5;
+        float extent = std::max({max.x - origin.x, max.y - origin.y, max.z - origin.z});
+        // 16 bits over the movement in a single block is well under a millimeter
+        float scale = std::max(extent, 0.001f) / INT16_MAX;
+        track.blocks.push_back({origin, scale});
+
+        for(size_t i = start; i < end; i++) {
+            auto offset = (transforms[i].position - origin) * (1 / scale);
+            track.positions.push_back({(int16_t) std::lround(offset.x), (int16_t) std::lround(offset.y), (int16_t) std::lround(offset.z)});
+            track.rotations.emplace_back(PackRotation(transforms[i].rotation));
+        }
+    }
+    transforms.clear();
+    transforms.shrink_to_fit();
+}
+
+Transform FrameStore::Unpack(const PackedTrack& track, size_t index) const {
+    auto& block = track.blocks[index / blockSize];
+    auto& position = track.positions[index];
+    return Transform(
+        block.origin + Vector3(position[0], position[1], position[2]) * block.scale,
+        UnpackRotation(track.rotations[index])
+    );
+}
+
+void FrameStore::Compress() {
+    if(compressed)
+        return;
+    compressed = true;
+
+    // fps almost never changes, so only store when it does
+    for(size_t i = 0; i < fps.size(); i++) {
+        if(fpsRuns.empty() || fpsRuns.back().fps != fps[i])
+            fpsRuns.push_back({i, fps[i]});
+    }
+    fps.clear();
+    fps.shrink_to_fit();
+
+    Pack(heads, packedHeads);
+    Pack(leftHands, packedLeftHands);
+    Pack(rightHands, packedRightHands);
+}
+
+int FrameStore::GetFps(size_t index) const {
+    auto run = std::upper_bound(fpsRuns.begin(), fpsRuns.end(), index, [](size_t index, const FpsRun& run) {
+        return index < run.start;
+    });
+    return (run - 1)->fps;
+}
+
+Frame FrameStore::operator[](size_t index) const {
+    if(!compressed)
+        return Frame(times[index], fps[index], heads[index], leftHands[index], rightHands[index]);
+    return Frame(times[index], GetFps(index), Unpack(packedHeads, index), Unpack(packedLeftHands, index), Unpack(packedRightHands, index));
+}
+
+void FrameSpline::Reset() {
+    source = nullptr;
+    segment = -1;
+    windowIndices = {-1, -1, -1, -1};
+}
+
+// position then rotation components
+inline std::array<float, 7> Channels(const Transform& transform) {
+    auto& pos = transform.position;
+    auto& rot = transform.rotation;
+    return {pos.x, pos.y, pos.z, rot.x, rot.y, rot.z, rot.w};
+}
+
+void FrameSpline::FitTrack(int offset, Transform Frame::*track) {
+    float t0 = window[0].time, t1 = window[1].time, t2 = window[2].time, t3 = window[3].time;
+    float length = t2 - t1;
+    // tangents from the neighbouring frames, weighted by time so uneven frame rates don't kink the curve
+    float startScale = t2 > t0 ? length / (t2 - t0) : 0;
+    float endScale = t3 > t1 ? length / (t3 - t1) : 0;
+
+    std::array<Transform, 4> points;
+    for(int i = 0; i < 4; i++)
+        points[i] = window[i].*track;
+    // keep each rotation in the same hemisphere as its neighbour so the curve takes the short way around
+    for(int i : {0, 2}) {
+        if(Quaternion::Dot(points[i].rotation, points[1].rotation) < 0)
+            points[i].rotation = InverseSignQuaternion(points[i].rotation);
+    }
+    if(Quaternion::Dot(points[3].rotation, points[2].rotation) < 0)
+        points[3].rotation = InverseSignQuaternion(points[3].rotation);
+
+    auto p0 = Channels(points[0]), p1 = Channels(points[1]), p2 = Channels(points[2]), p3 = Channels(points[3]);
+    // rotations are fit component-wise and normalized when evaluated, which is close enough to squad at capture rates
+    for(int i = 0; i < trackChannels; i++) {
+        float m1 = (p2[i] - p0[i]) * startScale;
+        float m2 = (p3[i] - p1[i]) * endScale;
+        a[offset + i] = p1[i];
+        b[offset + i] = m1;
+        c[offset + i] = 3 * (p2[i] - p1[i]) - 2 * m1 - m2;
+        d[offset + i] = 2 * (p1[i] - p2[i]) + m1 + m2;
+    }
+}
+
+void FrameSpline::Fit(const FrameStore& frames, int frame) {
+    if(&frames == source && frame == segment)
+        return;
+    if(&frames != source)
+        windowIndices = {-1, -1, -1, -1};
+    source = &frames;
+    segment = frame;
+
+    int last = frames.Size() - 1;
+    std::array<int, 4> indices = {std::max(frame - 1, 0), frame, std::min(frame + 1, last), std::min(frame + 2, last)};
+    // playback usually moves one segment at a time, so most of the window can be shifted over instead of decoded again
+    std::array<Frame, 4> next;
+    for(int i = 0; i < 4; i++) {
+        auto cached = std::find(windowIndices.begin(), windowIndices.end(), indices[i]);
+        if(cached != windowIndices.end())
+            next[i] = window[cached - windowIndices.begin()];
+        else
+            next[i] = frames[indices[i]];
+    }
+    window = next;
+    windowIndices = indices;
+
+    FitTrack(0, &Frame::head);
+    FitTrack(trackChannels, &Frame::leftHand);
+    FitTrack(trackChannels * 2, &Frame::rightHand);
+}
+
+inline Transform FromChannels(const float* values) {
+    Quaternion rot(values[3], values[4], values[5], values[6]);
+    float length = std::sqrt(rot.x * rot.x + rot.y * rot.y + rot.z * rot.z + rot.w * rot.w);
+    if(length > 0)
+        rot = Quaternion(rot.x / length, rot.y / length, rot.z / length, rot.w / length);
+    return Transform(Vector3(values[0], values[1], values[2]), rot);
+}
+
+Frame FrameSpline::Evaluate(float progress) const {
+    auto& start = window[1];
+    if(progress <= 0)
+        return start;
+    alignas(16) std::array<float, channelCount> values;
+    for(int i = 0; i < channelCount; i++)
+        values[i] = ((d[i] * progress + c[i]) * progress + b[i]) * progress + a[i];
+    return Frame(start.time, start.fps, FromChannels(&values[0]), FromChannels(&values[trackChannels]), FromChannels(&values[trackChannels * 2]));
+}
+
+Replay::Replay() = default;
+Replay::~Replay() = default;
+
+EventData& Replay::AddEventData() {
+    eventData = std::make_unique<EventData>(&arena);
+    return *eventData;
+}
+
+ScoreData& Replay::AddScoreData() {
+    scoreData = std::make_unique<ScoreData>(&arena);
+    return *scoreData;
+}
@@ -0,0 +1,44 @@
+#include "ReplayClock.hpp"
+
+#include <cmath>
+
+void ReplayClock::Start(Mode mode, float time, int fps) {
+    this->mode = mode;
+    this->fps = fps > 0 ? fps : 60;
+    maxDrift = 0;
+    Seek(time);
+}
+
+void ReplayClock::Seek(float time) {
+    this->time = time;
+    stepStart = time;
+    steps = 0;
+    drift = 0;
+}
+
+float ReplayClock::Advance(float deltaTime, float timeScale, float audioTime) {
+    switch(mode) {
+    case Mode::AudioLocked:
+        time = audioTime;
+        break;
+    case Mode::WallClock:
+        time += deltaTime * timeScale;
+        break;
+    case Mode::FixedStep:
+        if(timeScale != stepScale) {
+            stepStart = time;
+            steps = 0;
+            stepScale = timeScale;
+        }
+        steps++;
+        time = stepStart + steps * (double) timeScale / fps;
+        break;
+    }
+    return time;
+}
+
+void ReplayClock::MeasureDrift(float audioTime) {
+    drift = time - audioTime;
+    if(std::abs(drift) > std::abs(maxDrift))
+        maxDrift = drift;
+}
@@ -0,0 +1,459 @@
+#include "Main.hpp"
+#include "ReplayIndex.hpp"
+#include "Utils.hpp"
+#include "ReplayPacks.hpp"
+
+#include "lzma/pavlov/7zCrc.h"
+
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <unordered_map>
+#include <unordered_set>
+#include <chrono>
+#include <algorithm>
+#include <climits>
+
+namespace Index {
+
+    struct Fingerprint {
+        uintmax_t size;
+        std::filesystem::file_time_type modified;
+        uint32_t crc;
+    };
+
+    // a crc alone collides too often with thousands of replays, so the size and reader have to match too
+    struct LoadedKey {
+        uint32_t crc;
+        uintmax_t size;
+        ReplayWrapper(*reader)(const std::string&);
+
+        bool operator==(const LoadedKey&) const = default;
+    };
+
+    struct LoadedKeyHash {
+        size_t operator()(const LoadedKey& key) const {
+            size_t hash = std::hash<uintmax_t>()(key.size) ^ key.crc;
+            return hash ^ (std::hash<void*>()((void*) key.reader) << 1);
+        }
+    };
+
+    struct LoadedReplay {
+        ReplayType type;
+        std::weak_ptr<Replay> replay;
+        std::string path;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<std::string, Fingerprint> fingerprints;
+    // whether fingerprints differs from the last checkpoint on disk
+    bool fingerprintsChanged = false;
+    // only holds replays that are still referenced somewhere, so identical files are parsed once while in use
+    std::unordered_map<LoadedKey, LoadedReplay, LoadedKeyHash> loaded;
+
+    void EnsureCrcTable() {
+        static std::once_flag tableGenerated;
+        std::call_once(tableGenerated, CrcGenerateTable);
+    }
+
+    uint32_t CalculateCrc(const char* data, size_t size) {
+        EnsureCrcTable();
+        return CrcCalc(data, size);
+    }
+
+    std::optional<uint32_t> CalculateCrc(const std::string& path) {
+        EnsureCrcTable();
+        std::ifstream input(path, std::ios::binary);
+        if(!input.is_open())
+            return std::nullopt;
+        std::vector<char> buffer(1 << 16);
+        uint32_t crc = CRC_INIT_VAL;
+        while(input) {
+            input.read(buffer.data(), buffer.size());
+            crc = CrcUpdate(crc, buffer.data(), input.gcount());
+        }
+        return CRC_GET_DIGEST(crc);
+    }
+
+    std::optional<uint32_t> GetFingerprint(const std::string& path) {
+        std::error_code error;
+        auto size = std::filesystem::file_size(path, error);
+        if(error)
+            return Packs::GetCrc(path);
+        auto modified = std::filesystem::last_write_time(path, error);
+        if(error)
+            return std::nullopt;
+
+        {
+            std::lock_guard lock(mutex);
+            auto existing = fingerprints.find(path);
+            if(existing != fingerprints.end() && existing->second.size == size && existing->second.modified == modified)
+                return existing->second.crc;
+        }
+        auto crc = CalculateCrc(path);
+        if(crc) {
+            std::lock_guard lock(mutex);
+            fingerprints[path] = {size, modified, *crc};
+            fingerprintsChanged = true;
+        }
+        return crc;
+    }
+
+    ReplayWrapper Read(const std::string& path, ReplayWrapper(*reader)(const std::string&)) {
+        // a loose file takes priority in case it was copied back after being packed
+        if(!fileexists(path) && Packs::IsPacked(path))
+            return Packs::Load(path);
+        return reader(path);
+    }
+
+    // confirms a key match before sharing parsed data between two files
+    bool SameContents(const std::string& path1, const std::string& path2) {
+        std::ifstream input1(path1, std::ios::binary), input2(path2, std::ios::binary);
+        if(!input1.is_open() || !input2.is_open())
+            return false;
+        std::vector<char> buffer1(1 << 16), buffer2(1 << 16);
+        while(input1 && input2) {
+            input1.read(buffer1.data(), buffer1.size());
+            input2.read(buffer2.data(), buffer2.size());
+            if(input1.gcount() != input2.gcount() || !std::equal(buffer1.begin(), buffer1.begin() + input1.gcount(), buffer2.begin()))
+                return false;
+        }
+        return input1.eof() && input2.eof();
+    }
+
+    ReplayWrapper LoadReplay(const std::string& path, ReplayWrapper(*reader)(const std::string&)) {
+        // packed replays can't be compared cheaply, so they are never shared
+        std::error_code error;
+        auto size = std::filesystem::file_size(path, error);
+        auto crc = GetFingerprint(path);
+        if(error || !crc)
+            return Read(path, reader);
+        LoadedKey key{*crc, size, reader};
+
+        std::optional<LoadedReplay> existing;
+        {
+            std::lock_guard lock(mutex);
+            auto found = loaded.find(key);
+            if(found != loaded.end())
+                existing = found->second;
+        }
+        if(existing) {
+            auto replay = existing->replay.lock();
+            if(replay && (existing->path == path || SameContents(existing->path, path))) {
+                LOG_DEBUG("Reusing parsed replay for {}", path);
+                ReplayWrapper ret;
+                ret.type = existing->type;
+                ret.replay = replay;
+                return ret;
+            }
+        }
+        auto ret = Read(path, reader);
+        if(ret.IsValid()) {
+            std::lock_guard lock(mutex);
+            loaded[key] = {ret.type, ret.replay, path};
+        }
+        return ret;
+    }
+
+    void Evict(const Replay* replay) {
+        std::lock_guard lock(mutex);
+        std::erase_if(loaded, [replay](auto& pair) {
+            auto loadedReplay = pair.second.replay.lock();
+            return !loadedReplay || loadedReplay.get() == replay;
+        });
+    }
+
+    void Deduplicate(ReplayList& replays) {
+        std::unordered_set<Replay*> seen;
+        std::erase_if(replays, [&seen](auto& pair) {
+            bool duplicate = !seen.emplace(pair.second.replay.get()).second;
+            if(duplicate)
+                LOG_INFO("Skipping duplicate replay {}", pair.first);
+            return duplicate;
+        });
+    }
+
+    void Forget(const std::string& path) {
+        {
+            std::lock_guard lock(mutex);
+            if(fingerprints.erase(path))
+                fingerprintsChanged = true;
+        }
+        Packs::Remove(path);
+    }
+
+    const int checkpointVersion = 1;
+    // indexing works in short slices with pauses between them, so it never takes a whole core away from the game
+    const auto sliceLength = std::chrono::milliseconds(8);
+    const auto slicePause = std::chrono::milliseconds(24);
+    const auto checkpointInterval = std::chrono::seconds(10);
+
+    std::string GetCheckpointPath() {
+        static auto path = getDataDir("Replay") + "index.bin";
+        return path;
+    }
+
+    template<class T>
+    void WriteValue(std::ofstream& output, const T& value) {
+        output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<class T>
+    bool ReadValue(std::ifstream& input, T& value) {
+        input.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return input.good();
+    }
+
+    void LoadCheckpoint() {
+        std::ifstream input(GetCheckpointPath(), std::ios::binary);
+        if(!input.is_open())
+            return;
+        int version;
+        uint32_t count;
+        if(!ReadValue(input, version) || version != checkpointVersion || !ReadValue(input, count)) {
+            LOG_ERROR("Ignoring invalid replay index checkpoint");
+            return;
+        }
+        std::vector<std::pair<std::string, Fingerprint>> entries;
+        for(uint32_t i = 0; i < count; i++) {
+            uint32_t length;
+            uintmax_t size;
+            std::filesystem::file_time_type::rep modified;
+            uint32_t crc;
+            // a corrupt length could ask for gigabytes, and throwing here would take down the game
+            if(!ReadValue(input, length) || length > PATH_MAX) {
+                LOG_ERROR("Ignoring invalid replay index checkpoint");
+                return;
+            }
+            std::string path(length, '\0');
+            input.read(path.data(), length);
+            if(!input.good() || !ReadValue(input, size) || !ReadValue(input, modified) || !ReadValue(input, crc)) {
+                LOG_ERROR("Ignoring invalid replay index checkpoint");
+                return;
+            }
+            auto time = std::filesystem::file_time_type(std::filesystem::file_time_type::duration(modified));
+            entries.emplace_back(std::move(path), Fingerprint{size, time, crc});
+        }
+        std::lock_guard lock(mutex);
+        // anything already calculated this session is more recent
+        for(auto& [path, fingerprint] : entries)
+            fingerprints.emplace(std::move(path), fingerprint);
+        LOG_INFO("Loaded {} replay fingerprints from checkpoint", entries.size());
+    }
+
+    void SaveCheckpoint() {
+        std::vector<std::pair<std::string, Fingerprint>> entries;
+        {
+            std::lock_guard lock(mutex);
+            if(!fingerprintsChanged)
+                return;
+            fingerprintsChanged = false;
+            entries.assign(fingerprints.begin(), fingerprints.end());
+        }
+        // write to a temporary file first so a crash mid-write can't corrupt the previous checkpoint
+        auto path = GetCheckpointPath();
+        auto tempPath = path + ".tmp";
+        {
+            std::ofstream output(tempPath, std::ios::binary);
+            if(!output.is_open()) {
+                LOG_ERROR("Could not write replay index checkpoint");
+                return;
+            }
+            WriteValue(output, checkpointVersion);
+            WriteValue(output, (uint32_t) entries.size());
+            for(auto& [file, fingerprint] : entries) {
+                WriteValue(output, (uint32_t) file.size());
+                output.write(file.data(), file.size());
+                WriteValue(output, fingerprint.size);
+                WriteValue(output, fingerprint.modified.time_since_epoch().count());
+                WriteValue(output, fingerprint.crc);
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if(error)
+            LOG_ERROR("Could not replace replay index checkpoint: {}", error.message());
+    }
+
+    std::mutex indexingMutex;
+    std::optional<LevelKeys> priorityLevel;
+
+    void Prioritize(const LevelKeys& level) {
+        std::lock_guard lock(indexingMutex);
+        priorityLevel = level;
+    }
+
+    void IndexReplays() {
+        LoadCheckpoint();
+
+        auto files = FindAllReplayFiles();
+        LOG_INFO("Indexing {} replay files", files.size());
+
+        size_t next = 0;
+        auto lastCheckpoint = std::chrono::steady_clock::now();
+        while(next < files.size()) {
+            auto sliceEnd = std::chrono::steady_clock::now() + sliceLength;
+
+            std::optional<LevelKeys> level;
+            {
+                std::lock_guard lock(indexingMutex);
+                level.swap(priorityLevel);
+            }
+            if(level) {
+                try {
+                    for(auto& [path, reader] : FindLevelReplayFiles(*level))
+                        GetFingerprint(path);
+                } catch(const std::exception& e) {
+                    LOG_ERROR("Failure indexing replays for {}: {}", level->levelID, e.what());
+                }
+            }
+
+            // already fingerprinted files only cost a stat, so this goes quickly after the first run
+            while(next < files.size() && std::chrono::steady_clock::now() < sliceEnd)
+                GetFingerprint(files[next++].first);
+
+            if(std::chrono::steady_clock::now() - lastCheckpoint > checkpointInterval) {
+                SaveCheckpoint();
+                lastCheckpoint = std::chrono::steady_clock::now();
+            }
+            std::this_thread::sleep_for(slicePause);
+        }
+
+        // drop fingerprints of deleted files so the checkpoint doesn't grow forever
+        std::unordered_set<std::string> existing;
+        for(auto& [path, reader] : files)
+            existing.emplace(path);
+        {
+            std::lock_guard lock(mutex);
+            auto removed = std::erase_if(fingerprints, [&existing](auto& pair) {
+                return !existing.contains(pair.first);
+            });
+            if(removed > 0)
+                fingerprintsChanged = true;
+        }
+        SaveCheckpoint();
+        LOG_INFO("Finished indexing replay files");
+
+        Packs::PackColdReplays();
+    }
+
+    void IndexingThread() {
+        // an exception escaping this thread would terminate the game
+        try {
+            IndexReplays();
+        } catch(const std::exception& e) {
+            LOG_ERROR("Replay indexing stopped: {}", e.what());
+        }
+    }
+
+    void StartIndexing() {
+        static std::once_flag threadStarted;
+        std::call_once(threadStarted, [] { std::thread(IndexingThread).detach(); });
+    }
+
+    struct Listing {
+        std::filesystem::file_time_type modified;
+        std::shared_ptr<const std::vector<std::string>> names;
+    };
+
+    std::unordered_map<std::string, Listing> listings;
+
+    std::shared_ptr<const std::vector<std::string>> ListDirectory(const std::string& path) {
+        std::error_code error;
+        auto modified = std::filesystem::last_write_time(path, error);
+        if(error)
+            return std::make_shared<const std::vector<std::string>>();
+
+        {
+            std::lock_guard lock(mutex);
+            auto existing = listings.find(path);
+            if(existing != listings.end() && existing->second.modified == modified)
+                return existing->second.names;
+        }
+        auto names = std::make_shared<std::vector<std::string>>();
+        // range for would increment with the throwing overload, and this runs on background threads
+        std::filesystem::directory_iterator iterator(path, error);
+        for(; !error && iterator != std::filesystem::directory_iterator(); iterator.increment(error)) {
+            std::error_code entryError;
+            if(!iterator->is_directory(entryError))
+                names->emplace_back(iterator->path().filename().string());
+        }
+        if(error) {
+            // return what was found, but list again next time
+            LOG_ERROR("Failure listing {}: {}", path, error.message());
+            return names;
+        }
+        std::lock_guard lock(mutex);
+        listings[path] = {modified, names};
+        return names;
+    }
+
+    std::mutex prefetchMutex;
+    std::condition_variable prefetchCondition;
+    std::optional<LevelKeys> pendingPrefetch;
+    std::atomic_int prefetchGeneration = 0;
+    // keeps the replays of the highlighted level alive so the menu finds them already parsed
+    std::vector<ReplayWrapper> prefetched;
+
+    void PrefetchThread() {
+        // the readers use a few unity methods for rotations
+        il2cpp_functions::thread_attach(il2cpp_functions::domain_get());
+
+        while(true) {
+            std::unique_lock lock(prefetchMutex);
+            prefetchCondition.wait(lock, [] { return pendingPrefetch.has_value(); });
+            auto request = std::move(*pendingPrefetch);
+            pendingPrefetch.reset();
+            int generation = prefetchGeneration;
+            lock.unlock();
+
+            // an exception escaping this thread would terminate the game, so bad files are only logged and skipped
+            std::vector<std::pair<std::string, ReplayReader>> files;
+            try {
+                files = FindLevelReplayFiles(request);
+            } catch(const std::exception& e) {
+                LOG_ERROR("Failure finding replays to prefetch for {}: {}", request.levelID, e.what());
+            }
+            std::vector<ReplayWrapper> replays;
+            for(auto& [path, reader] : files) {
+                if(generation != prefetchGeneration)
+                    break;
+                try {
+                    auto replay = LoadReplay(path, reader);
+                    if(replay.IsValid())
+                        replays.emplace_back(std::move(replay));
+                } catch(const std::exception& e) {
+                    LOG_ERROR("Failure prefetching replay {}: {}", path, e.what());
+                }
+            }
+
+            lock.lock();
+            if(generation == prefetchGeneration) {
+                LOG_DEBUG("Prefetched {} replays for {}", replays.size(), request.levelID);
+                prefetched = std::move(replays);
+            }
+        }
+    }
+
+    void Prefetch(const LevelKeys& level) {
+        static std::once_flag threadStarted;
+        std::call_once(threadStarted, [] { std::thread(PrefetchThread).detach(); });
+
+        Prioritize(level);
+
+        std::lock_guard lock(prefetchMutex);
+        prefetchGeneration++;
+        pendingPrefetch = level;
+        prefetchCondition.notify_one();
+    }
+
+    void CancelPrefetch() {
+        std::lock_guard lock(prefetchMutex);
+        prefetchGeneration++;
+        pendingPrefetch.reset();
+        prefetched.clear();
+    }
+}
@@ -1,6 +1,8 @@
 #include "Main.hpp"
 #include "Config.hpp"
 #include "ReplayManager.hpp"
+#include "ReplayClock.hpp"
+#include "ReplayIndex.hpp"
 #include "MathUtils.hpp"
 #include "Utils.hpp"
 #include "MenuSelection.hpp"
@@ -27,16 +29,22 @@
 #include "GlobalNamespace/BeatmapObjectSpawnController.hpp"
 #include "GlobalNamespace/BeatmapCallbacksController.hpp"
 #include "GlobalNamespace/AudioTimeSyncController.hpp"
+#include "GlobalNamespace/AudioTimeSyncController_InitData.hpp"
 #include "GlobalNamespace/MainSettingsModelSO.hpp"
 #include "GlobalNamespace/IntSO.hpp"
 #include "GlobalNamespace/BoolSO.hpp"
 #include "UnityEngine/Transform.hpp"
 #include "UnityEngine/Resources.hpp"
 #include "UnityEngine/Time.hpp"
+#include "UnityEngine/AudioSource.hpp"
 #include "System/Collections/Generic/HashSet_1.hpp"
 #include "System/Action_1.hpp"
 #include "System/Action.hpp"
 
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+
 using namespace GlobalNamespace;
 
 struct NoteCompare {
@@ -47,7 +55,7 @@ struct NoteCompare {
     }
 };
 
-std::vector<std::pair<std::string, ReplayWrapper>> currentReplays;
+std::shared_ptr<const ReplayList> currentReplays;
 
 namespace Manager {
 
@@ -56,6 +64,21 @@ namespace Manager {
     float songTime = -1;
     float lerpAmount = 0;
     float lastCutTime = -1;
+    FrameSpline spline;
+    Pose pose;
+    bool fastForwarding = false;
+
+    void UpdatePose() {
+        // most poses are never seen when fast forwarding, so don't bother interpolating
+        if(fastForwarding) {
+            auto frame = currentReplay.replay->frames[currentFrame];
+            pose = {frame.head, frame.leftHand, frame.rightHand, currentReplay.replay->info.positionsAreLocal};
+            return;
+        }
+        spline.Fit(currentReplay.replay->frames, currentFrame);
+        auto frame = spline.Evaluate(lerpAmount);
+        pose = {frame.head, frame.leftHand, frame.rightHand, currentReplay.replay->info.positionsAreLocal};
+    }
 
     namespace Objects {
         Saber *leftSaber, *rightSaber;
@@ -110,8 +133,8 @@ namespace Manager {
         void UpdateTime() {
             if(GetMode() == (int) CameraMode::Smooth) {
                 float deltaTime = UnityEngine::Time::get_deltaTime();
-                smoothPosition = EaseLerp(smoothPosition, GetFrame().head.position, UnityEngine::Time::get_time(), deltaTime * 2 / getConfig().Smoothing.GetValue());
-                smoothRotation = Slerp(smoothRotation, GetFrame().head.rotation, deltaTime * 2 / getConfig().Smoothing.GetValue());
+                smoothPosition = EaseLerp(smoothPosition, pose.head.position, UnityEngine::Time::get_time(), deltaTime * 2 / getConfig().Smoothing.GetValue());
+                smoothRotation = Slerp(smoothRotation, pose.head.rotation, deltaTime * 2 / getConfig().Smoothing.GetValue());
             } else if(GetMode() == (int) CameraMode::ThirdPerson)
                 SetFromConfig();
         }
@@ -228,9 +251,42 @@ namespace Manager {
     }
 
     namespace Frames {
-        decltype(FrameReplay::scoreFrames)::iterator scoreFrame;
+        decltype(ScoreData::scoreFrames)::iterator scoreFrame;
         ScoreFrame currentValues;
-        FrameReplay* replay;
+        ScoreData* replay;
+        int comboDrop = 0;
+
+        // a drop is allowed when the first frame with a combo, starting two frames before the next unprocessed one,
+        // has a combo of 0 or is followed by a lower combo
+        void BuildComboDrops() {
+            if(replay->comboDropsBuilt)
+                return;
+            replay->comboDropsBuilt = true;
+            auto& frames = replay->scoreFrames;
+            int count = frames.size();
+            // whether the first frame with a combo at or after each frame shows a drop
+            std::vector<bool> drops(count);
+            bool drop = false, hasNext = false;
+            int nextCombo = 0;
+            for(int i = count - 1; i >= 0; i--) {
+                int combo = frames[i].combo;
+                if(combo >= 0) {
+                    drop = combo == 0 || (hasNext && nextCombo < combo);
+                    nextCombo = combo;
+                    hasNext = true;
+                }
+                drops[i] = drop;
+            }
+            for(int position = 0; position <= count; position++) {
+                int checked = std::max(position - 2, 0);
+                if(checked >= count || !drops[checked])
+                    continue;
+                if(!replay->comboDrops.empty() && replay->comboDrops.back().end == position)
+                    replay->comboDrops.back().end++;
+                else
+                    replay->comboDrops.push_back({position, position + 1});
+            }
+        }
 
         void Increment() {
             if(scoreFrame->score >= 0)
@@ -247,7 +303,9 @@ namespace Manager {
         }
 
         void ReplayStarted() {
-            replay = dynamic_cast<FrameReplay*>(currentReplay.replay.get());
+            replay = currentReplay.replay->scoreData.get();
+            BuildComboDrops();
+            comboDrop = 0;
             scoreFrame = replay->scoreFrames.begin();
             currentValues = {-1, -1, -1, -1, -1, -1};
             while(currentValues.score < 0 || currentValues.combo < 0 || currentValues.energy < 0 || currentValues.offset < 0)
@@ -264,30 +322,12 @@ namespace Manager {
         }
 
         bool AllowComboDrop() {
-            static int frameSearchRadius = 1;
-            int combo = 1;
-            auto iter = scoreFrame;
-            iter -= frameSearchRadius + 1;
-            for(int i = 0; i < frameSearchRadius; i++) {
-                iter--;
-                if(iter->combo < 0)
-                    i--;
-                if(iter == replay->scoreFrames.begin())
-                    break;
-            }
-            for(int i = 0; i < frameSearchRadius * 2; i++) {
-                iter++;
-                if(iter == replay->scoreFrames.end())
-                    break;
-                if(iter->combo < 0) {
-                    i--;
-                    continue;
-                }
-                if(iter->combo < combo)
-                    return true;
-                combo = iter->combo;
-            }
-            return false;
+            // the position only moves forward until the next restart, which resets the cursor
+            int position = scoreFrame - replay->scoreFrames.begin();
+            auto& windows = replay->comboDrops;
+            while(comboDrop < windows.size() && windows[comboDrop].end <= position)
+                comboDrop++;
+            return comboDrop < windows.size() && windows[comboDrop].begin <= position;
         }
 
         bool AllowScoreOverride() {
@@ -299,98 +339,148 @@ namespace Manager {
     }
 
     namespace Events {
-        std::set<NoteController*, NoteCompare> notes;
-        decltype(EventReplay::events)::iterator event;
-        EventReplay* replay;
-        float wallEndTime = 0;
+        // spawned notes grouped by NoteKey
+        std::unordered_map<int, std::set<NoteController*, NoteCompare>> notes;
+        std::unordered_map<NoteController*, int> noteKeys;
+        decltype(EventData::dispatch)::iterator event;
+        EventData* replay;
         float wallEnergyLoss = 0;
 
         void ReplayStarted() {
             notes.clear();
-            replay = dynamic_cast<EventReplay*>(currentReplay.replay.get());
-            event = replay->events.begin();
-            wallEndTime = 0;
+            noteKeys.clear();
+            replay = currentReplay.replay->eventData.get();
+            event = replay->dispatch.begin();
             wallEnergyLoss = 0;
         }
 
+        void SkipTo(float time) {
+            // matches the strict comparison in UpdateTime
+            event = std::lower_bound(replay->dispatch.begin(), replay->dispatch.end(), time, [](const DispatchEvent& event, float time) {
+                return event.time < time;
+            });
+        }
+
         void AddNoteController(NoteController* note) {
-            if(note->noteData->scoringType > NoteData::ScoringType::NoScore || note->noteData->gameplayType == NoteData::GameplayType::Bomb)
-                notes.insert(note);
+            auto noteData = note->noteData;
+            if(noteData->scoringType > NoteData::ScoringType::NoScore || noteData->gameplayType == NoteData::GameplayType::Bomb) {
+                int key = NoteKey(noteData->lineIndex, noteData->noteLineLayer.value, noteData->colorType.value, noteData->cutDirection.value);
+                notes[key].insert(note);
+                noteKeys[note] = key;
+            }
         }
         void RemoveNoteController(NoteController* note) {
-            auto iter = notes.find(note);
-            if(iter != notes.end())
-                notes.erase(iter);
+            auto key = noteKeys.find(note);
+            if(key == noteKeys.end())
+                return;
+            auto bucket = notes.find(key->second);
+            if(bucket != notes.end()) {
+                bucket->second.erase(note);
+                if(bucket->second.empty())
+                    notes.erase(bucket);
+            }
+            noteKeys.erase(key);
+        }
+
+        void LogMissingNote(const NoteEvent& event) {
+            int bsorID = (event.info.scoringType + 2)*10000 + event.info.lineIndex*1000 + event.info.lineLayer*100 + event.info.colorType*10 + event.info.cutDirection;
+            LOG_ERROR("Could not find note for event! time: {}, bsor id: {}", event.time, bsorID);
         }
 
-        void ProcessNoteEvent(const NoteEvent& event) {
+        NoteController* FindNote(const DispatchEvent& dispatch, const NoteEvent& event) {
+            auto bucket = notes.find(dispatch.key);
+            if(bucket == notes.end())
+                return nullptr;
+            // the bucket is in time order, so this picks the earliest matching note
+            // keys can collide for mapping extensions notes, so every field still has to be checked
             auto& info = event.info;
-            bool found = false;
-            for(auto iter = notes.begin(); iter != notes.end(); iter++) {
-                auto controller = *iter;
+            for(auto controller : bucket->second) {
                 auto noteData = controller->noteData;
                 if((noteData->scoringType == info.scoringType || info.scoringType == -2)
                         && noteData->lineIndex == info.lineIndex
                         && noteData->noteLineLayer == info.lineLayer
                         && noteData->colorType == info.colorType
-                        && noteData->cutDirection == info.cutDirection) {
-                    found = true;
-                    bool isLeftSaber = event.noteCutInfo.saberType == SaberType::SaberA;
-                    Saber* saber = isLeftSaber ? Objects::leftSaber : Objects::rightSaber;
-                    if(info.eventType == NoteEventInfo::Type::GOOD || info.eventType == NoteEventInfo::Type::BAD) {
-                        auto cutInfo = GetNoteCutInfo(controller, saber, event.noteCutInfo);
-                        if(replay->cutInfoMissingOKs) {
-                            cutInfo.speedOK = cutInfo.saberSpeed > 2;
-                            bool isLeftColor = noteData->colorType == ColorType::ColorA;
-                            cutInfo.saberTypeOK = isLeftColor == isLeftSaber;
-                            cutInfo.timeDeviation = noteData->time - event.time;
-                        }
-                        SetLastCutTime(event.time);
-                        il2cpp_utils::RunMethodUnsafe(controller, "SendNoteWasCutEvent", byref(cutInfo));
-                    } else if(info.eventType == NoteEventInfo::Type::MISS) {
-                        controller->SendNoteWasMissedEvent();
-                        notes.erase(iter); // note will despawn and be removed in the other cases
-                    } else if(info.eventType == NoteEventInfo::Type::BOMB) {
-                        auto cutInfo = GetBombCutInfo(controller, saber);
-                        il2cpp_utils::RunMethodUnsafe(controller, "SendNoteWasCutEvent", byref(cutInfo));
-                    }
-                    break;
+                        && noteData->cutDirection == info.cutDirection)
+                    return controller;
+            }
+            return nullptr;
+        }
+
+        // returns whether the note was cut
+        bool ProcessNoteEvent(const DispatchEvent& dispatch) {
+            auto& event = replay->notes[dispatch.index];
+            auto controller = FindNote(dispatch, event);
+            if(!controller) {
+                LogMissingNote(event);
+                return false;
+            }
+            bool isLeftSaber = event.noteCutInfo.saberType == SaberType::SaberA;
+            Saber* saber = isLeftSaber ? Objects::leftSaber : Objects::rightSaber;
+            switch(dispatch.type) {
+            case DispatchEvent::NoteCut: {
+                auto cutInfo = GetNoteCutInfo(controller, saber, event.noteCutInfo);
+                if(replay->cutInfoMissingOKs) {
+                    auto noteData = controller->noteData;
+                    cutInfo.speedOK = cutInfo.saberSpeed > 2;
+                    bool isLeftColor = noteData->colorType == ColorType::ColorA;
+                    cutInfo.saberTypeOK = isLeftColor == isLeftSaber;
+                    cutInfo.timeDeviation = noteData->time - event.time;
                 }
+                il2cpp_utils::RunMethodUnsafe(controller, "SendNoteWasCutEvent", byref(cutInfo));
+                return true;
             }
-            if(!found) {
-                int bsorID = (event.info.scoringType + 2)*10000 + event.info.lineIndex*1000 + event.info.lineLayer*100 + event.info.colorType*10 + event.info.cutDirection;
-                LOG_ERROR("Could not find note for event! time: {}, bsor id: {}", event.time, bsorID);
+            case DispatchEvent::NoteMiss:
+                controller->SendNoteWasMissedEvent();
+                RemoveNoteController(controller); // note will despawn and be removed in the other cases
+                return false;
+            case DispatchEvent::BombCut: {
+                auto cutInfo = GetBombCutInfo(controller, saber);
+                il2cpp_utils::RunMethodUnsafe(controller, "SendNoteWasCutEvent", byref(cutInfo));
+                return false;
+            }
+            default:
+                return false;
             }
         }
 
-        void ProcessWallEvent(const WallEvent& event) {
+        void ProcessWallEnter() {
             Objects::obstacleChecker->headDidEnterObstacleEvent->Invoke(nullptr);
             Objects::obstacleChecker->headDidEnterObstaclesEvent->Invoke();
-            float diffStartTime = std::max(wallEndTime, event.time);
-            wallEndTime = std::max(wallEndTime, event.endTime);
-            wallEnergyLoss += (wallEndTime - diffStartTime) * 1.3;
         }
 
         void UpdateTime() {
-            while(event != replay->events.end() && event->time < songTime) {
-                switch(event->eventType) {
-                case EventRef::Note:
-                    if(!notes.empty())
-                        ProcessNoteEvent(replay->notes[event->index]);
-                    break;
-                case EventRef::Wall:
-                    ProcessWallEvent(replay->walls[event->index]);
+            auto end = replay->dispatch.end();
+            // bookkeeping that only needs the latest value is applied once for every event due this frame
+            float lastCut = -1;
+            float addedContact = 0;
+            for(; event != end && event->time < songTime; event++) {
+                switch(event->type) {
+                case DispatchEvent::WallEnter:
+                    // the combo is broken in order with the notes around it
+                    ProcessWallEnter();
+                    [[fallthrough]];
+                case DispatchEvent::WallContact:
+                    addedContact += replay->walls[event->index].addedContact;
                     break;
                 default:
+                    if(!noteKeys.empty() && ProcessNoteEvent(*event))
+                        lastCut = event->time;
                     break;
                 }
-                event++;
             }
+            wallEnergyLoss += addedContact * 1.3;
+            if(lastCut >= 0)
+                SetLastCutTime(lastCut);
         }
     }
 
     bool replaying = false;
     bool paused = false;
+    bool scrubbing = false;
+    float scrubTime = 0;
+    ReplayClock clock;
+    // the clock takes the song time from the audio controller on the first update after starting or seeking
+    bool clockStarted = false;
     ReplayWrapper currentReplay;
     IDifficultyBeatmap* beatmap = nullptr;
 
@@ -404,15 +494,12 @@ namespace Manager {
             RefreshLevelReplays();
     }
 
-    void SetReplays(std::vector<std::pair<std::string, ReplayWrapper>> replays, bool external) {
-        currentReplays = replays;
-        if(currentReplays.size() > 0) {
+    void SetReplays(ReplayList replays, bool external) {
+        currentReplays = std::make_shared<const ReplayList>(std::move(replays));
+        if(currentReplays->size() > 0) {
             if(!external)
                 Menu::SetButtonEnabled(true);
-            std::vector<std::pair<std::string, ReplayInfo*>> replayInfos;
-            for(auto& pair : currentReplays)
-                replayInfos.emplace_back(pair.first, &pair.second.replay->info);
-            Menu::SetReplays(replayInfos, external);
+            Menu::SetReplays(currentReplays, external);
         } else if(!external) {
             Menu::SetButtonEnabled(false);
             Menu::DismissMenu();
@@ -427,16 +514,49 @@ namespace Manager {
         SetReplays(GetReplays(beatmap));
     }
 
-    void ReplayStarted(ReplayWrapper& wrapper) {
+    std::shared_ptr<const ReplayList> GetLevelReplays() {
+        if(!AreReplaysLocal())
+            return nullptr;
+        return currentReplays;
+    }
+
+    ReplayClock::Mode DefaultClockMode() {
+        // video renders capture at a fixed rate regardless of how long frames take, so the song has to as well
+        if(Camera::rendering && !Camera::GetAudioMode())
+            return ReplayClock::Mode::FixedStep;
+        return ReplayClock::Mode::AudioLocked;
+    }
+
+    void SetFastForward(bool value) {
+        if(fastForwarding == value)
+            return;
+        LOG_INFO("Fast forward {}", value ? "started" : "stopped");
+        fastForwarding = value;
+        // the audio can't keep up, so the song follows real time instead
+        clock.Start(value ? ReplayClock::Mode::WallClock : DefaultClockMode(), songTime, getConfig().FPS.GetValue());
+        clockStarted = false;
+    }
+
+    void ReplayStarted(const ReplayWrapper& wrapper) {
+        Index::CancelPrefetch();
         currentReplay = wrapper;
-        frameCount = currentReplay.replay->frames.size();
+        // 4k renders are usually limited by memory rather than time
+        if(Camera::rendering && getConfig().CompressFrames.GetValue())
+            currentReplay.replay->frames.Compress();
+        frameCount = currentReplay.replay->frames.Size();
+        spline.Reset();
         bs_utils::Submission::disable(modInfo);
         replaying = true;
         paused = false;
+        scrubbing = false;
         currentFrame = 0;
         songTime = -1;
         lerpAmount = 0;
         lastCutTime = -1;
+        fastForwarding = false;
+        UpdatePose();
+        clock.Start(DefaultClockMode(), 0, getConfig().FPS.GetValue());
+        clockStarted = false;
         if(currentReplay.type & ReplayType::Event)
             Events::ReplayStarted();
         if(currentReplay.type & ReplayType::Frame)
@@ -445,15 +565,22 @@ namespace Manager {
     }
 
     void ReplayStarted(const std::string& path) {
-        for(auto& pair : currentReplays) {
+        if(!currentReplays)
+            return;
+        for(auto& pair : *currentReplays) {
             if(pair.first == path)
                 ReplayStarted(pair.second);
         }
     }
 
     void ReplayRestarted(bool full) {
-        if(full)
+        if(full) {
             paused = false;
+            fastForwarding = false;
+            clock.Start(DefaultClockMode(), 0, getConfig().FPS.GetValue());
+        }
+        scrubbing = false;
+        clockStarted = false;
         currentFrame = 0;
         songTime = full ? -1 : 0;
         lerpAmount = 0;
@@ -465,9 +592,20 @@ namespace Manager {
     }
 
     void ReplayEnded(bool quit) {
+        LOG_INFO("Replay clock drift from audio at end {:.3f}, max {:.3f}", clock.GetDrift(), clock.GetMaxDrift());
         Camera::ReplayEnded();
         bs_utils::Submission::enable(modInfo);
         replaying = false;
+        // the parsed replay is shared, so the lossy copy used for the render can't be handed out again
+        if(currentReplay.replay->frames.IsCompressed()) {
+            auto compressed = currentReplay.replay.get();
+            Index::Evict(compressed);
+            bool listed = currentReplays && std::any_of(currentReplays->begin(), currentReplays->end(), [compressed](auto& pair) {
+                return pair.second.replay.get() == compressed;
+            });
+            if(listed && AreReplaysLocal())
+                RefreshLevelReplays();
+        }
         if(Camera::rendering && !quit) {
             // render audio after all video renders
             if(getConfig().AudioMode.GetValue()) {
@@ -487,9 +625,18 @@ namespace Manager {
         }
     }
 
+    void StopScrubbing() {
+        if(!scrubbing)
+            return;
+        scrubbing = false;
+        Pause::EndScrub(scrubTime);
+    }
+
     void ReplayPaused() {
-        Pause::EnsureSetup(Objects::pauseManager);
         paused = true;
+        // set the scrubbed time first so the pause menu starts from it
+        StopScrubbing();
+        Pause::EnsureSetup(Objects::pauseManager);
         Camera::moving = false;
     }
 
@@ -498,29 +645,53 @@ namespace Manager {
         paused = false;
     }
 
-    void UpdateTime(float time) {
-        if(songTime < 0) {
-            if(time != 0)
-                return;
-            Objects::GetObjects();
+    // playback only moves a frame or two at a time, anything further than this is treated as a seek
+    const int maxFrameWalk = 8;
+
+    // index of the last frame at or before the time, or the first frame if there is none
+    int FindFrame(float time) {
+        auto& times = currentReplay.replay->frames.Times();
+        int frame = currentFrame;
+        if(frame < frameCount && times[frame] <= time) {
+            int limit = std::min(frame + maxFrameWalk, frameCount);
+            while(frame < limit && times[frame] <= time)
+                frame++;
+            if(frame < limit || frame == frameCount)
+                return frame - 1;
         }
-        if(currentReplay.type == ReplayType::Frame)
-            time += 0.01;
-        songTime = time;
-        auto& frames = currentReplay.replay->frames;
+        auto next = std::upper_bound(times.begin(), times.begin() + frameCount, time);
+        return std::max((int) (next - times.begin()) - 1, 0);
+    }
+
+    // frame replays are matched slightly ahead of the song time so their cuts line up with the notes
+    const float frameReplayLead = 0.01;
 
-        while(currentFrame < frameCount && frames[currentFrame].time <= songTime)
-            currentFrame++;
-        if(currentFrame > 0)
-            currentFrame--;
+    // moves the pose to the time without processing anything that happened in between
+    void UpdateFrame(float time) {
+        auto& times = currentReplay.replay->frames.Times();
+
+        currentFrame = FindFrame(time);
 
         if(currentFrame == frameCount - 1)
             lerpAmount = 0;
         else {
-            float timeDiff = songTime - frames[currentFrame].time;
-            float frameDur = frames[currentFrame + 1].time - frames[currentFrame].time;
+            float timeDiff = time - times[currentFrame];
+            float frameDur = times[currentFrame + 1] - times[currentFrame];
             lerpAmount = timeDiff / frameDur;
         }
+        UpdatePose();
+    }
+
+    void UpdateTime(float time) {
+        if(songTime < 0) {
+            if(time != 0)
+                return;
+            Objects::GetObjects();
+        }
+        if(currentReplay.type == ReplayType::Frame)
+            time += frameReplayLead;
+        songTime = time;
+        UpdateFrame(songTime);
         if(currentReplay.type & ReplayType::Event)
             Events::UpdateTime();
         if(currentReplay.type & ReplayType::Frame)
@@ -528,6 +699,28 @@ namespace Manager {
         Camera::UpdateTime();
     }
 
+    bool ClockDrivesSong() {
+        return replaying && clock.GetMode() != ReplayClock::Mode::AudioLocked;
+    }
+
+    void UpdateClock(AudioTimeSyncController* audio) {
+        if(!replaying || paused || scrubbing)
+            return;
+        if(!clockStarted) {
+            clock.Seek(audio->songTime);
+            clockStarted = true;
+        }
+        float time = clock.Advance(UnityEngine::Time::get_deltaTime(), audio->timeScale, audio->songTime);
+        if(ClockDrivesSong()) {
+            audio->lastFrameDeltaSongTime = time - audio->songTime;
+            audio->songTime = time;
+            audio->isReady = true;
+        }
+        // the audio is left behind while fast forwarding
+        if(!fastForwarding && audio->audioSource->get_isPlaying())
+            clock.MeasureDrift(audio->audioSource->get_time() - audio->initData->songTimeOffset);
+    }
+
     void SetLastCutTime(float value) {
         lastCutTime = value;
     }
@@ -535,10 +728,33 @@ namespace Manager {
     bool timeForwardPressed = false, timeBackPressed = false;
     bool speedUpPressed = false, slowDownPressed = false;
 
+    void UpdateScrub() {
+        auto button = getConfig().ScrubButton.GetValue();
+        if(!IsButtonDown(button)) {
+            StopScrubbing();
+            return;
+        }
+        if(!scrubbing) {
+            scrubbing = true;
+            scrubTime = songTime;
+            Pause::StartScrub();
+        }
+        // the song is paused, so use real time for the speed
+        float speed = GetJoystickX(button.Controller) * getConfig().ScrubSpeed.GetValue();
+        scrubTime = Pause::ClampTime(scrubTime + UnityEngine::Time::get_unscaledDeltaTime() * speed);
+        UpdateFrame(scrubTime);
+        Camera::UpdateTime();
+        Pause::PreviewScrub(scrubTime);
+    }
+
     void CheckInputs() {
         if(Camera::rendering)
             return;
 
+        UpdateScrub();
+        if(scrubbing)
+            return;
+
         int timeState = IsButtonDown(getConfig().TimeButton.GetValue());
         if(timeState == 1 && !timeForwardPressed)
             Pause::SetTime(GetSongTime() + getConfig().TimeSkip.GetValue());
@@ -548,10 +764,8 @@ namespace Manager {
         timeBackPressed = timeState == -1;
 
         int speedState = IsButtonDown(getConfig().SpeedButton.GetValue());
-        if(speedState == 1 && !speedUpPressed)
-            Pause::SetSpeed(Objects::scoreController->audioTimeSyncController->timeScale + 0.1);
-        else if(speedState == -1 && !slowDownPressed)
-            Pause::SetSpeed(Objects::scoreController->audioTimeSyncController->timeScale - 0.1);
+        if(speedState != 0 && !(speedState == 1 ? speedUpPressed : slowDownPressed))
+            Pause::SetSpeed(Pause::StepSpeed(Objects::scoreController->audioTimeSyncController->timeScale, speedState));
         speedUpPressed = speedState == 1;
         slowDownPressed = speedState == -1;
 
@@ -564,11 +778,11 @@ namespace Manager {
         return songTime;
     }
 
-    const Frame& GetFrame() {
+    Frame GetFrame() {
         return currentReplay.replay->frames[currentFrame];
     }
 
-    const Frame& GetNextFrame() {
+    Frame GetNextFrame() {
         if(currentFrame == frameCount - 1)
             return currentReplay.replay->frames[currentFrame];
         else
@@ -578,4 +792,8 @@ namespace Manager {
     float GetFrameProgress() {
         return lerpAmount;
     }
+
+    const Pose& GetPose() {
+        return pose;
+    }
 }
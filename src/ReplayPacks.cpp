@@ -0,0 +1,318 @@
+#include "Main.hpp"
+#include "ReplayPacks.hpp"
+#include "ReplayIndex.hpp"
+#include "Config.hpp"
+#include "Utils.hpp"
+
+#include "Formats/EventReplay.hpp"
+
+#include "lzma/lzma.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <mutex>
+#include <unordered_map>
+#include <chrono>
+#include <set>
+
+#include <climits>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace Packs {
+
+    // replays are compressed and appended to the end of a pack, whose entries are never rewritten
+    // removing a packed replay only drops it from the table, leaving its data in the pack
+    struct PackedReplay {
+        int pack;
+        uint64_t offset;
+        uint32_t compressedSize;
+        uint32_t size;
+        uint32_t crc;
+    };
+
+    const int tableVersion = 1;
+    const uint64_t maxPackSize = 64 * 1024 * 1024;
+
+    std::mutex mutex;
+    // keyed by the path the replay had as a loose file, so the rest of the mod can keep using it
+    std::unordered_map<std::string, PackedReplay> table;
+
+    std::string GetPacksPath() {
+        static auto path = getDataDir("Replay") + "packs/";
+        return path;
+    }
+
+    std::string GetTablePath() {
+        return GetPacksPath() + "table.bin";
+    }
+
+    std::string GetPackPath(int pack) {
+        return GetPacksPath() + std::to_string(pack) + ".pack";
+    }
+
+    template<class T>
+    void WriteValue(std::ostream& output, const T& value) {
+        output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<class T>
+    bool ReadValue(std::istream& input, T& value) {
+        input.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return input.good();
+    }
+
+    void LoadTable() {
+        std::ifstream input(GetTablePath(), std::ios::binary);
+        if(!input.is_open())
+            return;
+        int version;
+        uint32_t count;
+        if(!ReadValue(input, version) || version != tableVersion || !ReadValue(input, count)) {
+            LOG_ERROR("Invalid replay pack table");
+            return;
+        }
+        for(uint32_t i = 0; i < count; i++) {
+            uint32_t length;
+            if(!ReadValue(input, length) || length > PATH_MAX) {
+                LOG_ERROR("Invalid replay pack table entry");
+                break;
+            }
+            std::string path(length, '\0');
+            input.read(path.data(), length);
+            PackedReplay entry;
+            if(!input.good() || !ReadValue(input, entry))
+                break;
+            table.emplace(std::move(path), entry);
+        }
+        LOG_INFO("Loaded {} packed replays", table.size());
+    }
+
+    // makes sure a written file is on disk before anything depending on it is deleted
+    bool SyncFile(const std::string& path) {
+        int file = open(path.c_str(), O_RDONLY);
+        if(file < 0)
+            return false;
+        bool synced = fsync(file) == 0;
+        close(file);
+        return synced;
+    }
+
+    // expects the mutex to be held
+    bool SaveTable() {
+        auto path = GetTablePath();
+        auto tempPath = path + ".tmp";
+        {
+            std::ofstream output(tempPath, std::ios::binary);
+            if(!output.is_open()) {
+                LOG_ERROR("Could not write replay pack table");
+                return false;
+            }
+            WriteValue(output, tableVersion);
+            WriteValue(output, (uint32_t) table.size());
+            for(auto& [file, entry] : table) {
+                WriteValue(output, (uint32_t) file.size());
+                output.write(file.data(), file.size());
+                WriteValue(output, entry);
+            }
+            output.close();
+            if(output.fail()) {
+                LOG_ERROR("Failure writing replay pack table");
+                return false;
+            }
+        }
+        if(!SyncFile(tempPath)) {
+            LOG_ERROR("Could not sync replay pack table");
+            return false;
+        }
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if(error) {
+            LOG_ERROR("Could not replace replay pack table: {}", error.message());
+            return false;
+        }
+        return true;
+    }
+
+    // reads and decompresses a packed replay, checking it against the crc of the original file
+    bool ReadEntry(const PackedReplay& entry, std::vector<char>& decompressed) {
+        std::ifstream pack(GetPackPath(entry.pack), std::ios::binary);
+        if(!pack.is_open())
+            return false;
+        std::vector<char> compressed(entry.compressedSize);
+        pack.seekg(entry.offset);
+        pack.read(compressed.data(), compressed.size());
+        decompressed.clear();
+        decompressed.reserve(entry.size);
+        if(!pack.good() || !LZMA::lzmaDecompress(compressed, decompressed) || decompressed.size() != entry.size)
+            return false;
+        return Index::CalculateCrc(decompressed.data(), decompressed.size()) == entry.crc;
+    }
+
+    std::unique_lock<std::mutex> LockTable() {
+        static std::once_flag tableLoaded;
+        std::call_once(tableLoaded, LoadTable);
+        return std::unique_lock(mutex);
+    }
+
+    bool IsPacked(const std::string& path) {
+        auto lock = LockTable();
+        return table.contains(path);
+    }
+
+    std::optional<uint32_t> GetCrc(const std::string& path) {
+        auto lock = LockTable();
+        auto entry = table.find(path);
+        if(entry == table.end())
+            return std::nullopt;
+        return entry->second.crc;
+    }
+
+    ReplayWrapper Load(const std::string& path) {
+        PackedReplay entry;
+        {
+            auto lock = LockTable();
+            auto found = table.find(path);
+            if(found == table.end()) {
+                LOG_ERROR("Replay {} is not packed", path);
+                return {};
+            }
+            entry = found->second;
+        }
+        std::vector<char> decompressed;
+        if(!ReadEntry(entry, decompressed)) {
+            LOG_ERROR("Failure reading packed replay {} from pack {}", path, entry.pack);
+            return {};
+        }
+        std::stringstream input;
+        input.write(decompressed.data(), decompressed.size());
+        return ReadBSOR(input, path);
+    }
+
+    std::vector<std::string> ListPacked(const std::string& directory) {
+        std::vector<std::string> ret;
+        auto lock = LockTable();
+        for(auto& [path, entry] : table) {
+            if(path.starts_with(directory) && path.find('/', directory.size()) == std::string::npos)
+                ret.emplace_back(path.substr(directory.size()));
+        }
+        return ret;
+    }
+
+    void Remove(const std::string& path) {
+        auto lock = LockTable();
+        if(table.erase(path))
+            SaveTable();
+    }
+
+    void PackColdReplays() {
+        if(!getConfig().PackReplays.GetValue())
+            return;
+
+        auto cutoff = std::filesystem::file_time_type::clock::now() - std::chrono::hours(24 * getConfig().PackAge.GetValue());
+        std::vector<std::string> cold;
+        std::error_code error;
+        for(auto& name : *Index::ListDirectory(GetBSORsPath())) {
+            auto path = GetBSORsPath() + name;
+            if(!name.ends_with(".bsor") || IsPacked(path))
+                continue;
+            auto modified = std::filesystem::last_write_time(path, error);
+            if(!error && modified < cutoff)
+                cold.emplace_back(path);
+        }
+        if(cold.empty())
+            return;
+        LOG_INFO("Packing {} replays", cold.size());
+
+        if(!direxists(GetPacksPath()))
+            mkpath(GetPacksPath());
+
+        int pack = 0;
+        {
+            auto lock = LockTable();
+            for(auto& [path, entry] : table)
+                pack = std::max(pack, entry.pack);
+        }
+        uint64_t packSize = std::filesystem::file_size(GetPackPath(pack), error);
+        if(error)
+            packSize = 0;
+
+        std::vector<std::pair<std::string, PackedReplay>> packed;
+        std::set<int> written;
+        std::ofstream output;
+        for(auto& path : cold) {
+            auto crc = Index::GetFingerprint(path);
+            std::ifstream input(path, std::ios::binary);
+            if(!crc || !input.is_open())
+                continue;
+            std::vector<char> contents(std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{});
+            std::vector<char> compressed;
+            if(!LZMA::lzmaCompress(contents, compressed)) {
+                LOG_ERROR("Failure compressing replay {}", path);
+                continue;
+            }
+
+            if(packSize >= maxPackSize) {
+                output.close();
+                if(output.fail()) {
+                    LOG_ERROR("Failure writing replay pack {}", pack);
+                    break;
+                }
+                pack++;
+                packSize = 0;
+            }
+            if(!output.is_open()) {
+                output.open(GetPackPath(pack), std::ios::binary | std::ios::app);
+                if(!output.is_open()) {
+                    LOG_ERROR("Could not open replay pack {}", pack);
+                    break;
+                }
+                written.emplace(pack);
+            }
+            output.write(compressed.data(), compressed.size());
+            if(!output.good()) {
+                LOG_ERROR("Failure writing replay {} to pack {}", path, pack);
+                break;
+            }
+            packed.emplace_back(path, PackedReplay{pack, packSize, (uint32_t) compressed.size(), (uint32_t) contents.size(), *crc});
+            packSize += compressed.size();
+        }
+        if(output.is_open())
+            output.close();
+        // a failed close only loses data that wasn't confirmed yet, which the read back below catches
+        for(int file : written) {
+            if(!SyncFile(GetPackPath(file))) {
+                LOG_ERROR("Could not sync replay pack {}", file);
+                return;
+            }
+        }
+
+        // only replays whose packed copy reads back intact are kept
+        std::erase_if(packed, [](auto& pair) {
+            std::vector<char> contents;
+            bool intact = ReadEntry(pair.second, contents);
+            if(!intact)
+                LOG_ERROR("Packed copy of replay {} is not intact, keeping the file", pair.first);
+            return !intact;
+        });
+        if(packed.empty())
+            return;
+
+        // the loose files are only removed once the table pointing to their packed copies is saved
+        {
+            auto lock = LockTable();
+            for(auto& [path, entry] : packed)
+                table[path] = entry;
+            if(!SaveTable()) {
+                // the table on disk doesn't have them, so don't pretend they are packed either
+                for(auto& [path, entry] : packed)
+                    table.erase(path);
+                return;
+            }
+        }
+        for(auto& [path, entry] : packed)
+            std::filesystem::remove(path, error);
+        LOG_INFO("Packed {} replays", packed.size());
+    }
+}
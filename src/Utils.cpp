@@ -2,19 +2,18 @@
 #include "Utils.hpp"
 #include "Config.hpp"
 #include "Assets.hpp"
+#include "ReplayIndex.hpp"
+#include "ReplayPacks.hpp"
 
 #include "Formats/EventFrame.hpp"
 
 #include "CustomTypes/MovementData.hpp"
 
-#include "GlobalNamespace/IDifficultyBeatmapSet.hpp"
-#include "GlobalNamespace/BeatmapDifficulty.hpp"
-#include "GlobalNamespace/BeatmapDifficultySerializedMethods.hpp"
-#include "GlobalNamespace/BeatmapCharacteristicSO.hpp"
 #include "GlobalNamespace/SharedCoroutineStarter.hpp"
 #include "GlobalNamespace/NoteData.hpp"
 #include "GlobalNamespace/ScoreModel_NoteScoreDefinition.hpp"
 #include "GlobalNamespace/OVRInput_Button.hpp"
+#include "GlobalNamespace/OVRInput_Axis2D.hpp"
 #include "UnityEngine/GameObject.hpp"
 #include "UnityEngine/AudioClip.hpp"
 #include "UnityEngine/AudioSource.hpp"
@@ -27,7 +26,7 @@
 #include <filesystem>
 #include <chrono>
 #include <sstream>
-#include <regex>
+#include <algorithm>
 
 using namespace GlobalNamespace;
 
@@ -58,13 +57,7 @@ std::string GetSSReplaysPath() {
 }
 
 std::string GetHash(IPreviewBeatmapLevel* level) {
-    std::string id = level->get_levelID();
-    // should be in all songloader levels
-    auto prefixIndex = id.find("custom_level_");
-    if(prefixIndex != std::string::npos)
-        id.erase(0, 13);
-    std::transform(id.begin(), id.end(), id.begin(), tolower);
-    return id;
+    return GetLevelKeys(level).hash;
 }
 
 const std::string reqlaySuffix1 = ".reqlay";
@@ -72,18 +65,39 @@ const std::string reqlaySuffix2 = ".questReplayFileForQuestDontTryOnPcAlsoPinkEr
 const std::string bsorSuffix = ".bsor";
 const std::string ssSuffix = ".dat";
 
-void GetReqlays(IDifficultyBeatmap* beatmap, std::vector<std::pair<std::string, ReplayWrapper>>& replays) {
+bool IsReqlay(const std::string& name, const std::string& start) {
+    return name.starts_with(start) && (name.ends_with(reqlaySuffix1) || name.ends_with(reqlaySuffix2));
+}
+
+bool IsBSOR(const std::string& name, const std::string& search) {
+    if(!name.ends_with(bsorSuffix))
+        return false;
+    return std::string_view(name).substr(0, name.size() - bsorSuffix.size()).find(search) != std::string::npos;
+}
+
+bool IsSSReplay(const std::string& name, const std::string& ending) {
+    if(!name.ends_with(ssSuffix))
+        return false;
+    return std::string_view(name).substr(0, name.size() - ssSuffix.size()).ends_with(ending);
+}
+
+// packed replays are listed as if they were still in the folder
+std::vector<std::string> ListBSORs() {
+    auto names = *Index::ListDirectory(GetBSORsPath());
+    auto packed = Packs::ListPacked(GetBSORsPath());
+    names.insert(names.end(), packed.begin(), packed.end());
+    return names;
+}
+
+void GetReqlays(const DifficultyKeys& keys, ReplayList& replays) {
     std::vector<std::string> tests;
 
-    std::string hash = GetHash((IPreviewBeatmapLevel*) beatmap->get_level());
-    std::string diff = std::to_string((int) beatmap->get_difficulty());
-    std::string mode = beatmap->get_parentDifficultyBeatmapSet()->get_beatmapCharacteristic()->compoundIdPartName;
-    std::string reqlayName = GetReqlaysPath() + hash + diff + mode;
+    std::string reqlayName = GetReqlaysPath() + keys.reqlayName;
     tests.emplace_back(reqlayName + reqlaySuffix1);
     tests.emplace_back(reqlayName + reqlaySuffix2);
     for(auto& path : tests) {
         if(fileexists(path)) {
-            auto replay = ReadReqlay(path);
+            auto replay = Index::LoadReplay(path, ReadReqlay);
             if(replay.IsValid()) {
                 replays.emplace_back(path, replay);
                 LOG_INFO("Read reqlay from {}", path);
@@ -92,73 +106,91 @@ void GetReqlays(IDifficultyBeatmap* beatmap, std::vector<std::pair<std::string,
     }
 }
 
-void GetBSORs(IDifficultyBeatmap* beatmap, std::vector<std::pair<std::string, ReplayWrapper>>& replays) {
-    std::string diffName = BeatmapDifficultySerializedMethods::SerializedName(beatmap->get_difficulty());
-    if(diffName == "Unknown")
-        diffName = "Error";
-    std::string characteristic = beatmap->get_parentDifficultyBeatmapSet()->get_beatmapCharacteristic()->serializedName;
-
-    std::string bsorHash = regex_replace((std::string)((IPreviewBeatmapLevel*) beatmap->get_level())->get_levelID(), std::basic_regex("custom_level_"), "");
+void GetBSORs(const DifficultyKeys& keys, ReplayList& replays) {
     // sadly, because of beatleader's naming scheme, it's impossible to come up with a reasonably sized set of candidates
-    std::string search = fmt::format("{}-{}-{}", diffName, characteristic, bsorHash);
-    for(const auto& entry : std::filesystem::directory_iterator(GetBSORsPath())) {
-        if(!entry.is_directory()) {
-            auto path = entry.path();
-            if(path.extension() == bsorSuffix && path.stem().string().find(search) != std::string::npos) {
-                auto replay = ReadBSOR(path.string());
-                if(replay.IsValid()) {
-                    replays.emplace_back(path.string(), replay);
-                    LOG_INFO("Read bsor from {}", path.string());
-                }
+    for(auto& name : ListBSORs()) {
+        if(IsBSOR(name, keys.bsorSearch)) {
+            auto path = GetBSORsPath() + name;
+            auto replay = Index::LoadReplay(path, ReadBSOR);
+            if(replay.IsValid()) {
+                replays.emplace_back(path, replay);
+                LOG_INFO("Read bsor from {}", path);
             }
         }
     }
 }
 
-void GetSSReplays(IDifficultyBeatmap* beatmap, std::vector<std::pair<std::string, ReplayWrapper>>& replays) {
-    auto previewBeatmap = (IPreviewBeatmapLevel*) beatmap->get_level();
-
-    std::string diffName = BeatmapDifficultySerializedMethods::SerializedName(beatmap->get_difficulty());
-    std::string characteristic = beatmap->get_parentDifficultyBeatmapSet()->get_beatmapCharacteristic()->serializedName;
-    std::string songName = previewBeatmap->get_songName();
-    std::string levelHash = previewBeatmap->get_levelID();
-
-    if(levelHash.find("custom_level_") == std::string::npos)
-        levelHash = "ost_" + levelHash;
-    else
-        levelHash = levelHash.substr(13);
-
-    std::string ending = fmt::format("-{}-{}-{}-{}", songName, diffName, characteristic, levelHash);
-
-    for(const auto& entry : std::filesystem::directory_iterator(GetSSReplaysPath())) {
-        if(!entry.is_directory()) {
-            auto path = entry.path();
-            if(path.extension() == ssSuffix && path.stem().string().ends_with(ending)) {
-                auto replay = ReadScoresaber(path.string());
-                if(replay.IsValid()) {
-                    replays.emplace_back(path.string(), replay);
-                    LOG_INFO("Read scoresaber replay from {}", path.string());
-                }
+void GetSSReplays(const DifficultyKeys& keys, ReplayList& replays) {
+    for(auto& name : *Index::ListDirectory(GetSSReplaysPath())) {
+        if(IsSSReplay(name, keys.ssEnding)) {
+            auto path = GetSSReplaysPath() + name;
+            auto replay = Index::LoadReplay(path, ReadScoresaber);
+            if(replay.IsValid()) {
+                replays.emplace_back(path, replay);
+                LOG_INFO("Read scoresaber replay from {}", path);
             }
         }
     }
 }
 
-std::vector<std::pair<std::string, ReplayWrapper>> GetReplays(IDifficultyBeatmap* beatmap) {
-    std::vector<std::pair<std::string, ReplayWrapper>> replays;
+ReplayList GetReplays(IDifficultyBeatmap* beatmap) {
+    ReplayList replays;
+    auto& keys = GetDifficultyKeys(beatmap);
 
     if(std::filesystem::exists(GetReqlaysPath()))
-        GetReqlays(beatmap, replays);
+        GetReqlays(keys, replays);
 
     if(std::filesystem::exists(GetBSORsPath()))
-        GetBSORs(beatmap, replays);
+        GetBSORs(keys, replays);
 
     if(std::filesystem::exists(GetSSReplaysPath()))
-        GetSSReplays(beatmap, replays);
+        GetSSReplays(keys, replays);
+
+    // the same run can be saved in multiple places, such as an imported copy of a bsor
+    Index::Deduplicate(replays);
 
     return replays;
 }
 
+std::vector<std::pair<std::string, ReplayReader>> FindLevelReplayFiles(const LevelKeys& level) {
+    std::vector<std::pair<std::string, ReplayReader>> files;
+
+    std::string ssEnding = "-" + level.ssHash;
+    std::string ssSongName = "-" + level.songName + "-";
+
+    for(auto& name : *Index::ListDirectory(GetReqlaysPath())) {
+        if(IsReqlay(name, level.hash))
+            files.emplace_back(GetReqlaysPath() + name, ReadReqlay);
+    }
+    for(auto& name : ListBSORs()) {
+        if(IsBSOR(name, level.bsorHash))
+            files.emplace_back(GetBSORsPath() + name, ReadBSOR);
+    }
+    for(auto& name : *Index::ListDirectory(GetSSReplaysPath())) {
+        if(IsSSReplay(name, ssEnding) && name.find(ssSongName) != std::string::npos)
+            files.emplace_back(GetSSReplaysPath() + name, ReadScoresaber);
+    }
+    return files;
+}
+
+std::vector<std::pair<std::string, ReplayReader>> FindAllReplayFiles() {
+    std::vector<std::pair<std::string, ReplayReader>> files;
+
+    for(auto& name : *Index::ListDirectory(GetReqlaysPath())) {
+        if(IsReqlay(name, ""))
+            files.emplace_back(GetReqlaysPath() + name, ReadReqlay);
+    }
+    for(auto& name : ListBSORs()) {
+        if(IsBSOR(name, ""))
+            files.emplace_back(GetBSORsPath() + name, ReadBSOR);
+    }
+    for(auto& name : *Index::ListDirectory(GetSSReplaysPath())) {
+        if(IsSSReplay(name, ""))
+            files.emplace_back(GetSSReplaysPath() + name, ReadScoresaber);
+    }
+    return files;
+}
+
 std::string GetStringForTimeSinceNow(std::time_t start) {
     auto startTimePoint = std::chrono::system_clock::from_time_t(start);
     auto duration = std::chrono::system_clock::now() - startTimePoint;
@@ -407,87 +439,123 @@ void AddEnergy(float& energy, float addition, const ReplayModifiers& modifiers)
         energy = 0;
 }
 
+void SimulateEvent(ScoreState& state, const EventData& eventData, const EventRef& event, const ReplayModifiers& modifiers) {
+    // add wall energy change since last event, before the new event in case it is a new wall
+    float wallContact = WallContactUntil(eventData, event.time);
+    if(wallContact > state.wallContact) {
+        AddEnergy(state.energy, -1.3 * (wallContact - state.wallContact), modifiers);
+        state.wallContact = wallContact;
+    }
+    switch(event.eventType) {
+    case EventRef::Note: {
+        state.recentNoteTime = event.time;
+        auto& note = eventData.notes[event.index];
+        if(note.info.eventType != NoteEventInfo::Type::BOMB) {
+            UpdateMultiplier(state.maxMultiplier, state.maxMultiplierProgress, true);
+            state.maxScore += ScoreForNote(note, true) * state.maxMultiplier;
+        }
+        if(note.info.eventType == NoteEventInfo::Type::GOOD) {
+            UpdateMultiplier(state.multiplier, state.multiplierProgress, true);
+            state.score += ScoreForNote(note) * state.multiplier;
+            state.combo += 1;
+            state.maxCombo = std::max(state.maxCombo, state.combo);
+        } else {
+            UpdateMultiplier(state.multiplier, state.multiplierProgress, false);
+            state.combo = 0;
+        }
+        AddEnergy(state.energy, EnergyForNote(note.info), modifiers);
+        break;
+    }
+    case EventRef::Wall:
+        // combo doesn't get set back to 0 if you enter a wall while inside of one
+        if(eventData.walls[event.index].entersWall) {
+            UpdateMultiplier(state.multiplier, state.multiplierProgress, false);
+            state.combo = 0;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// events or frames between each saved checkpoint
+const size_t checkpointInterval = 64;
+
+void BuildScoreCheckpoints(EventData& eventData, const ReplayModifiers& modifiers) {
+    if(!eventData.scoreCheckpoints.empty())
+        return;
+    ScoreState state;
+    if(modifiers.oneLife || modifiers.fourLives)
+        state.energy = 1;
+    eventData.scoreCheckpoints.reserve(eventData.events.size() / checkpointInterval + 1);
+    for(size_t i = 0; i < eventData.events.size(); i++) {
+        if(i % checkpointInterval == 0)
+            eventData.scoreCheckpoints.emplace_back(state);
+        SimulateEvent(state, eventData, eventData.events[i], modifiers);
+    }
+    if(eventData.scoreCheckpoints.empty())
+        eventData.scoreCheckpoints.emplace_back(state);
+}
+
+ScoreState ScoreStateAtTime(const ReplayWrapper& replay, float time) {
+    auto& eventData = *replay.replay->eventData;
+    auto& modifiers = replay.replay->info.modifiers;
+    BuildScoreCheckpoints(eventData, modifiers);
+    size_t end = EventsUntil(eventData, time) - eventData.events.begin();
+    size_t checkpoint = std::min(end / checkpointInterval, eventData.scoreCheckpoints.size() - 1);
+    auto state = eventData.scoreCheckpoints[checkpoint];
+    for(size_t i = checkpoint * checkpointInterval; i < end; i++)
+        SimulateEvent(state, eventData, eventData.events[i], modifiers);
+    return state;
+}
+
+void AddScoreFrame(ScoreFrame& values, const ScoreFrame& frame) {
+    if(frame.score >= 0)
+        values.score = frame.score;
+    if(frame.percent >= 0)
+        values.percent = frame.percent;
+    if(frame.combo >= 0)
+        values.combo = frame.combo;
+    if(frame.energy >= 0)
+        values.energy = frame.energy;
+}
+
+ScoreFrame ScoreFrameAtTime(ScoreData& scoreData, float time) {
+    auto& frames = scoreData.scoreFrames;
+    if(scoreData.checkpoints.empty()) {
+        auto values = ScoreFrame(0, 0, -1, 0, 1, 0);
+        scoreData.checkpoints.reserve(frames.size() / checkpointInterval + 1);
+        for(size_t i = 0; i < frames.size(); i++) {
+            if(i % checkpointInterval == 0)
+                scoreData.checkpoints.emplace_back(values);
+            AddScoreFrame(values, frames[i]);
+        }
+        if(scoreData.checkpoints.empty())
+            scoreData.checkpoints.emplace_back(values);
+    }
+    size_t end = std::upper_bound(frames.begin(), frames.end(), time, [](float time, const ScoreFrame& frame) {
+        return time < frame.time;
+    }) - frames.begin();
+    size_t checkpoint = std::min(end / checkpointInterval, scoreData.checkpoints.size() - 1);
+    auto values = scoreData.checkpoints[checkpoint];
+    for(size_t i = checkpoint * checkpointInterval; i < end; i++)
+        AddScoreFrame(values, frames[i]);
+    return values;
+}
+
 MapPreview MapAtTime(const ReplayWrapper& replay, float time) {
     MapPreview ret{};
     float recentNoteTime = -1;
     if(replay.type & ReplayType::Event) {
-        auto eventReplay = dynamic_cast<EventReplay*>(replay.replay.get());
-        auto& modifiers = eventReplay->info.modifiers;
-        int multiplier = 1, multiProg = 0;
-        int maxMultiplier = 1, maxMultiProg = 0;
-        float lastCalculatedWall = 0, wallEnd = 0;
-        int score = 0;
-        int maxScore = 0;
-        int combo = 0;
-        float energy = 0.5;
-        if(modifiers.oneLife || modifiers.fourLives)
-            energy = 1;
-        for(auto& event: eventReplay->events) {
-            if(event.time > time)
-                break;
-            // add wall energy change since last event
-            if(lastCalculatedWall != wallEnd) {
-                if(event.time < wallEnd) {
-                    AddEnergy(energy, 1.3 * (lastCalculatedWall - event.time), modifiers);
-                    lastCalculatedWall = event.time;
-                } else {
-                    AddEnergy(energy, 1.3 * (lastCalculatedWall - wallEnd), modifiers);
-                    lastCalculatedWall = wallEnd;
-                }
-            }
-            switch(event.eventType) {
-            case EventRef::Note: {
-                recentNoteTime = event.time;
-                auto& note = eventReplay->notes[event.index];
-                if(note.info.eventType != NoteEventInfo::Type::BOMB) {
-                    UpdateMultiplier(maxMultiplier, maxMultiProg, true);
-                    maxScore += ScoreForNote(note, true) * maxMultiplier;
-                }
-                if(note.info.eventType == NoteEventInfo::Type::GOOD) {
-                    UpdateMultiplier(multiplier, multiProg, true);
-                    score += ScoreForNote(note) * multiplier;
-                    combo += 1;
-                } else {
-                    UpdateMultiplier(multiplier, multiProg, false);
-                    combo = 0;
-                }
-                AddEnergy(energy, EnergyForNote(note.info), modifiers);
-                break;
-            }
-            case EventRef::Wall:
-                // combo doesn't get set back to 0 if you enter a wall while inside of one
-                if(event.time > wallEnd) {
-                    UpdateMultiplier(multiplier, multiProg, false);
-                    combo = 0;
-                }
-                // step through wall energy loss instead of doing it all at once
-                lastCalculatedWall = event.time;
-                wallEnd = std::max(wallEnd, eventReplay->walls[event.index].endTime);
-                break;
-            default:
-                break;
-            }
-        }
-        ret.energy = energy;
-        ret.combo = combo;
-        ret.score = score;
-        ret.maxScore = maxScore;
+        auto state = ScoreStateAtTime(replay, time);
+        recentNoteTime = state.recentNoteTime;
+        ret.energy = state.energy;
+        ret.combo = state.combo;
+        ret.score = state.score;
+        ret.maxScore = state.maxScore;
     }
     if(replay.type & ReplayType::Frame) {
-        auto frames = dynamic_cast<FrameReplay*>(replay.replay.get())->scoreFrames;
-        auto recentValues = ScoreFrame(0, 0, -1, 0, 1, 0);
-        for(auto& frame : frames) {
-            if(frame.time > time)
-                break;
-            if(frame.score >= 0)
-                recentValues.score = frame.score;
-            if(frame.percent >= 0)
-                recentValues.percent = frame.percent;
-            if(frame.combo >= 0)
-                recentValues.combo = frame.combo;
-            if(frame.energy >= 0)
-                recentValues.energy = frame.energy;
-        }
+        auto recentValues = ScoreFrameAtTime(*replay.replay->scoreData, time);
         ret.energy = recentValues.energy;
         ret.combo = recentValues.combo;
         if(time - recentNoteTime > 0.4)
@@ -535,6 +603,16 @@ int IsButtonDown(const ButtonPair& button) {
     return ret;
 }
 
+float GetJoystickX(int controller) {
+    auto axis = OVRInput::Axis2D::PrimaryThumbstick;
+    if(controller == 2) {
+        float left = OVRInput::Get(axis, controllers[0]).x;
+        float right = OVRInput::Get(axis, controllers[1]).x;
+        return std::abs(left) > std::abs(right) ? left : right;
+    }
+    return OVRInput::Get(axis, controllers[controller]).x;
+}
+
 void PlayDing() {
     static const int offset = 44;
     static const int frequency = 44100;
@@ -1,61 +1,65 @@
 #include "lzma/lzma.hpp"
-#include <mutex>
+
+#include <algorithm>
 
 namespace LZMA
 {
-    const std::vector<char> *input_data;
-    int input_index;
-
-    std::vector<char> *output_data;
+    // the stream is the first member, so the pointer passed to the callbacks is also a pointer to the state
+    // keeping the state per call lets compression on a background thread run alongside decompression on the main thread
+    struct InputStream {
+        ISeqInStream stream;
+        const std::vector<char> *data;
+        size_t index;
+    };
 
-    std::mutex lock; // lazy threadsafety
+    struct OutputStream {
+        ISeqOutStream stream;
+        std::vector<char> *data;
+    };
 
     SRes Read(const ISeqInStream *pp, void *buf, size_t *size)
     {
-        size_t orig_size = *size;
-        for(*size = 0; *size < orig_size && input_index < input_data->size(); ++*size) {
-            reinterpret_cast<char*>(buf)[*size] = (*input_data)[input_index++];
-        }
+        auto input = reinterpret_cast<InputStream*>(const_cast<ISeqInStream*>(pp));
+        *size = std::min(*size, input->data->size() - input->index);
+        std::copy_n(input->data->data() + input->index, *size, reinterpret_cast<char*>(buf));
+        input->index += *size;
         return SZ_OK;
     }
 
     size_t Write(const ISeqOutStream *pp, const void *data, size_t size)
     {
-        for(size_t i = 0; i < size; ++i)
-            output_data->push_back(reinterpret_cast<const char*>(data)[i]);
+        auto output = reinterpret_cast<OutputStream*>(const_cast<ISeqOutStream*>(pp));
+        auto bytes = reinterpret_cast<const char*>(data);
+        output->data->insert(output->data->end(), bytes, bytes + size);
         return size;
     }
 
-    void initialize_input(const std::vector<char> &in, ISeqInStream &stream) {
-        input_data = &in;
-        input_index = 0;
-        stream.Read = Read;
+    void initialize_input(const std::vector<char> &in, InputStream &stream) {
+        stream.stream.Read = Read;
+        stream.data = &in;
+        stream.index = 0;
     }
 
-    void initialize_output(std::vector<char> &out, ISeqOutStream &stream) {
-        output_data = &out;
-        stream.Write = Write;
+    void initialize_output(std::vector<char> &out, OutputStream &stream) {
+        stream.stream.Write = Write;
+        stream.data = &out;
     }
 
     bool lzmaDecompress(const std::vector<char> &in, std::vector<char> &out) {
-        std::lock_guard<std::mutex> guard(lock);
-
-        ISeqInStream instream;
-        ISeqOutStream outstream;
+        InputStream instream;
+        OutputStream outstream;
         initialize_input(in, instream);
         initialize_output(out, outstream);
 
-        return Decode(&outstream, &instream) == SZ_OK;
+        return Decode(&outstream.stream, &instream.stream) == SZ_OK;
     }
 
     bool lzmaCompress(const std::vector<char> &in, std::vector<char> &out) {
-        std::lock_guard<std::mutex> guard(lock);
-
-        ISeqInStream instream;
-        ISeqOutStream outstream;
+        InputStream instream;
+        OutputStream outstream;
         initialize_input(in, instream);
         initialize_output(out, outstream);
 
-        return Encode(&outstream, &instream, in.size()) == SZ_OK;
+        return Encode(&outstream.stream, &instream.stream, in.size()) == SZ_OK;
     }
 }
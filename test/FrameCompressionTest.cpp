@@ -0,0 +1,96 @@
+#include "Replay.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+// defined in Replay.cpp without a header, as nothing else packs single rotations
+uint32_t PackRotation(const Quaternion& rotation);
+Quaternion UnpackRotation(uint32_t packed);
+
+// the bounds documented on FrameStore::PackedTrack
+const float maxAngleDegrees = 0.3;
+const float maxPositionError = 0.0001;
+
+std::mt19937 generator(1234);
+
+Quaternion RandomRotation() {
+    std::normal_distribution<float> normal;
+    float x = normal(generator), y = normal(generator), z = normal(generator), w = normal(generator);
+    float length = std::sqrt(x * x + y * y + z * z + w * w);
+    return Quaternion(x / length, y / length, z / length, w / length);
+}
+
+float AngleDegrees(const Quaternion& a, const Quaternion& b) {
+    double dot = std::min(1.0, std::abs((double) Quaternion::Dot(a, b)));
+    return 2 * std::acos(dot) * 180 / M_PI;
+}
+
+float Distance(const Vector3& a, const Vector3& b) {
+    auto difference = a - b;
+    return std::sqrt(difference.x * difference.x + difference.y * difference.y + difference.z * difference.z);
+}
+
+int failures = 0;
+
+void Check(bool passed, const char* name, float measured, float bound) {
+    std::printf("%s %s: %g (bound %g)\n", passed ? "PASS" : "FAIL", name, measured, bound);
+    if(!passed)
+        failures++;
+}
+
+void TestRotations() {
+    float worst = 0;
+    for(int i = 0; i < 1000000; i++) {
+        auto rotation = RandomRotation();
+        worst = std::max(worst, AngleDegrees(rotation, UnpackRotation(PackRotation(rotation))));
+    }
+    // the largest component is rebuilt from the other three, and amplifies their error most when all four are close to 1/2
+    std::uniform_real_distribution<float> offset(-0.02, 0.02);
+    for(int i = 0; i < 1000000; i++) {
+        float x = 0.5 + offset(generator), y = 0.5 + offset(generator), z = 0.5 + offset(generator), w = 0.5 + offset(generator);
+        float length = std::sqrt(x * x + y * y + z * z + w * w);
+        Quaternion rotation(x / length, y / length, z / length, w / length);
+        worst = std::max(worst, AngleDegrees(rotation, UnpackRotation(PackRotation(rotation))));
+    }
+    Check(worst < maxAngleDegrees, "rotation angle (degrees)", worst, maxAngleDegrees);
+}
+
+void TestFrameStore() {
+    std::uniform_real_distribution<float> step(-0.05, 0.05);
+    FrameStore frames;
+    std::vector<Frame> original;
+    Vector3 head(0, 1.7, 0), left(-0.3, 1, 0.2), right(0.3, 1, 0.2);
+    // a few seconds of fast swinging at 90 fps, including a jump of a couple meters between blocks
+    for(int i = 0; i < 1000; i++) {
+        if(i == 500)
+            head = head + Vector3(2, 0, 1);
+        head = head + Vector3(step(generator), step(generator), step(generator)) * 0.1;
+        left = left + Vector3(step(generator), step(generator), step(generator));
+        right = right + Vector3(step(generator), step(generator), step(generator));
+        Frame frame(i / 90.0f, 90, Transform(head, RandomRotation()), Transform(left, RandomRotation()), Transform(right, RandomRotation()));
+        original.push_back(frame);
+        frames.Add(frame);
+    }
+    frames.Compress();
+
+    float worstPosition = 0, worstAngle = 0;
+    bool timesMatch = frames.Size() == original.size();
+    for(size_t i = 0; timesMatch && i < original.size(); i++) {
+        auto frame = frames[i];
+        timesMatch = frame.time == original[i].time && frame.fps == original[i].fps;
+        for(auto track : {&Frame::head, &Frame::leftHand, &Frame::rightHand}) {
+            worstPosition = std::max(worstPosition, Distance((frame.*track).position, (original[i].*track).position));
+            worstAngle = std::max(worstAngle, AngleDegrees((frame.*track).rotation, (original[i].*track).rotation));
+        }
+    }
+    Check(timesMatch, "frame times and fps", 0, 0);
+    Check(worstPosition < maxPositionError, "position distance (meters)", worstPosition, maxPositionError);
+    Check(worstAngle < maxAngleDegrees, "frame rotation angle (degrees)", worstAngle, maxAngleDegrees);
+}
+
+int main() {
+    TestRotations();
+    TestFrameStore();
+    return failures > 0;
+}
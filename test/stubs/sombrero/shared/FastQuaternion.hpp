@@ -0,0 +1,31 @@
+#pragma once
+
+// just enough of sombrero for the frame codec to build on the host, the mod uses the real library
+
+namespace Sombrero {
+    struct FastQuaternion {
+        float x = 0, y = 0, z = 0, w = 1;
+
+        constexpr FastQuaternion() = default;
+        constexpr FastQuaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+        static constexpr float Dot(const FastQuaternion& a, const FastQuaternion& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+    };
+
+    inline FastQuaternion QuaternionMultiply(const FastQuaternion& a, const FastQuaternion& b) {
+        return {
+            a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y + a.y * b.w + a.z * b.x - a.x * b.z,
+            a.w * b.z + a.z * b.w + a.x * b.y - a.y * b.x,
+            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+        };
+    }
+}
+
+namespace UnityEngine {
+    struct Quaternion {
+        static Sombrero::FastQuaternion Inverse(const Sombrero::FastQuaternion& rotation) {
+            return {-rotation.x, -rotation.y, -rotation.z, rotation.w};
+        }
+    };
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// just enough of sombrero for the frame codec to build on the host, the mod uses the real library
+
+namespace Sombrero {
+    struct FastVector3 {
+        float x = 0, y = 0, z = 0;
+
+        constexpr FastVector3() = default;
+        constexpr FastVector3(float x, float y, float z) : x(x), y(y), z(z) {}
+
+        constexpr FastVector3 operator+(const FastVector3& other) const { return {x + other.x, y + other.y, z + other.z}; }
+        constexpr FastVector3 operator-(const FastVector3& other) const { return {x - other.x, y - other.y, z - other.z}; }
+        constexpr FastVector3 operator*(float scale) const { return {x * scale, y * scale, z * scale}; }
+    };
+}